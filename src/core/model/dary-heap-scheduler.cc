@@ -0,0 +1,236 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "dary-heap-scheduler.h"
+#include "event-impl.h"
+#include "assert.h"
+#include "log.h"
+#include "unused.h"
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::DaryHeapScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("DaryHeapScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (DaryHeapScheduler);
+
+TypeId
+DaryHeapScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::DaryHeapScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<DaryHeapScheduler> ()
+  ;
+  return tid;
+}
+
+DaryHeapScheduler::DaryHeapScheduler ()
+  : m_keyOffset (0),
+    m_size (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+DaryHeapScheduler::~DaryHeapScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+Scheduler::EventKey &
+DaryHeapScheduler::Key (std::size_t index)
+{
+  return m_keys[m_keyOffset + index];
+}
+
+const Scheduler::EventKey &
+DaryHeapScheduler::Key (std::size_t index) const
+{
+  return m_keys[m_keyOffset + index];
+}
+
+bool
+DaryHeapScheduler::IsLess (const Scheduler::EventKey &a, const Scheduler::EventKey &b)
+{
+  return a.m_ts < b.m_ts || (a.m_ts == b.m_ts && a.m_uid < b.m_uid);
+}
+
+void
+DaryHeapScheduler::Grow (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::size_t capacity = std::max<std::size_t> (2 * m_events.size (), 64);
+  // allocate room for the padding needed to align the keys
+  std::vector<Scheduler::EventKey> keys (capacity + ARITY - 1);
+  uintptr_t address = reinterpret_cast<uintptr_t> (keys.data ());
+  std::size_t offset = 0;
+  if (address % sizeof (Scheduler::EventKey) == 0)
+    {
+      // index of the first key aligned on a group of ARITY keys
+      std::size_t group = ARITY * sizeof (Scheduler::EventKey);
+      std::size_t aligned = ((group - address % group) % group) / sizeof (Scheduler::EventKey);
+      // the first child of the root must be aligned
+      offset = (aligned + ARITY - 1) % ARITY;
+    }
+  std::copy (m_keys.begin () + m_keyOffset, m_keys.begin () + m_keyOffset + m_size, keys.begin () + offset);
+  m_keys.swap (keys);
+  m_keyOffset = offset;
+  m_events.resize (capacity);
+}
+
+void
+DaryHeapScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  if (m_size == m_events.size ())
+    {
+      Grow ();
+    }
+  // move the hole left by the new event up to the position of the event
+  std::size_t index = m_size++;
+  while (index > 0)
+    {
+      std::size_t parent = (index - 1) / ARITY;
+      if (!IsLess (ev.key, Key (parent)))
+        {
+          break;
+        }
+      Key (index) = Key (parent);
+      m_events[index] = m_events[parent];
+      index = parent;
+    }
+  Key (index) = ev.key;
+  m_events[index] = ev.impl;
+}
+
+bool
+DaryHeapScheduler::IsEmpty (void) const
+{
+  NS_LOG_FUNCTION (this);
+  // the root is never a removed event
+  return m_size == 0;
+}
+
+Scheduler::Event
+DaryHeapScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_size > 0);
+  Event next;
+  next.impl = m_events[0];
+  next.key = Key (0);
+  return next;
+}
+
+Scheduler::Event
+DaryHeapScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  Event next = PeekNext ();
+  PopRoot ();
+  DiscardRemoved ();
+  return next;
+}
+
+void
+DaryHeapScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (m_size > 0);
+  if (Key (0).m_uid == ev.key.m_uid)
+    {
+      NS_ASSERT (m_events[0] == ev.impl);
+      PopRoot ();
+      DiscardRemoved ();
+      return;
+    }
+  // the event is discarded when it reaches the root of the heap
+  bool inserted = m_removed.insert (ev.key.m_uid).second;
+  NS_ASSERT_MSG (inserted, "Event " << ev.key.m_uid << " removed twice");
+  NS_UNUSED (inserted);
+}
+
+void
+DaryHeapScheduler::PopRoot (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::size_t size = --m_size;
+  if (size == 0)
+    {
+      return;
+    }
+  Scheduler::EventKey last = Key (size);
+  EventImpl *lastEvent = m_events[size];
+  // move the hole left by the root down to the position of the last event
+  std::size_t index = 0;
+  while (true)
+    {
+      std::size_t first = index * ARITY + 1;
+      if (first >= size)
+        {
+          break;
+        }
+      std::size_t smallest;
+      if (first + ARITY <= size)
+        {
+          // all the children exist: find the smallest one with a tournament
+          // that the compiler can turn into conditional moves
+          std::size_t a = first + (IsLess (Key (first + 1), Key (first)) ? 1 : 0);
+          std::size_t b = first + 2 + (IsLess (Key (first + 3), Key (first + 2)) ? 1 : 0);
+          smallest = IsLess (Key (b), Key (a)) ? b : a;
+        }
+      else
+        {
+          smallest = first;
+          for (std::size_t child = first + 1; child < size; child++)
+            {
+              if (IsLess (Key (child), Key (smallest)))
+                {
+                  smallest = child;
+                }
+            }
+        }
+      if (!IsLess (Key (smallest), last))
+        {
+          break;
+        }
+      Key (index) = Key (smallest);
+      m_events[index] = m_events[smallest];
+      index = smallest;
+    }
+  Key (index) = last;
+  m_events[index] = lastEvent;
+}
+
+void
+DaryHeapScheduler::DiscardRemoved (void)
+{
+  NS_LOG_FUNCTION (this);
+  while (!m_removed.empty () && m_size > 0
+         && m_removed.erase (Key (0).m_uid) > 0)
+    {
+      NS_LOG_DEBUG ("Discard removed event " << Key (0).m_uid);
+      PopRoot ();
+    }
+}
+
+} // namespace ns3
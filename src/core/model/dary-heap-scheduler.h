@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef DARY_HEAP_SCHEDULER_H
+#define DARY_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+#include <stdint.h>
+#include <vector>
+#include <unordered_set>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::DaryHeapScheduler declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup scheduler
+ * \brief a d-ary heap event scheduler with lazy removal
+ *
+ * This scheduler stores the events in a 4-ary heap laid out in
+ * contiguous arrays. The keys of the events (timestamp, uid and context,
+ * 16 bytes) are stored apart from the pointers to the events, and the
+ * array of keys is aligned so that the keys of the four children of a
+ * node fill exactly one 64-byte cache line. Compared to a binary heap,
+ * the tree is half as deep and percolating an event down the heap loads
+ * a single cache line per level. Percolation moves a hole rather than
+ * swapping events.
+ *
+ * Remove() does not search the heap: unless the event is the next one,
+ * its uid is recorded in a hash set and the event is discarded when it
+ * reaches the root of the heap. Hence, the root of the heap is always an
+ * event that has not been removed. Note that Simulator::Cancel does not
+ * involve the scheduler at all, the cancelled events being skipped by the
+ * simulator when they are removed from the event list.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | Logarithmic     | Heapify
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Heap kept sorted
+ * Remove()     | Constant        | Hash set insertion (the event is discarded by RemoveNext())
+ * RemoveNext() | Logarithmic     | Heapify
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 128 bytes                        | `std::vector` x 2 and `std::unordered_set`
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ *
+ * Removed events keep their slot in the heap (and use a node of the hash
+ * set) until they reach its root.
+ */
+class DaryHeapScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  DaryHeapScheduler ();
+  /** Destructor. */
+  virtual ~DaryHeapScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /** The number of children of each node of the heap. */
+  static const std::size_t ARITY = 4;
+
+  /**
+   * \param [in] index The index of a node of the heap.
+   * \returns The key of the event at the given node.
+   */
+  inline Scheduler::EventKey & Key (std::size_t index);
+  /**
+   * \param [in] index The index of a node of the heap.
+   * \returns The key of the event at the given node.
+   */
+  inline const Scheduler::EventKey & Key (std::size_t index) const;
+  /**
+   * Compare (less than) two keys.
+   *
+   * \param [in] a The first key.
+   * \param [in] b The second key.
+   * \returns \c true if \c a < \c b
+   */
+  static inline bool IsLess (const Scheduler::EventKey &a, const Scheduler::EventKey &b);
+  /** Double the capacity of the heap, keeping the array of keys aligned. */
+  void Grow (void);
+  /** Remove the root of the heap. */
+  void PopRoot (void);
+  /** Remove the events at the root of the heap until the root is not a removed event. */
+  void DiscardRemoved (void);
+
+  /**
+   * The keys of the events, managed as a heap whose root is at index
+   * m_keyOffset. The children of the node at index i (relative to the
+   * root) are at indices ARITY * i + 1 to ARITY * i + ARITY.
+   */
+  std::vector<Scheduler::EventKey> m_keys;
+  /** The offset of the root in the array of keys, chosen to align the children of each node. */
+  std::size_t m_keyOffset;
+  /** The events, at the same index as their key (relative to the root). */
+  std::vector<EventImpl *> m_events;
+  /** The number of events in the heap. */
+  std::size_t m_size;
+  /** The uids of the removed events that are still in the heap. */
+  std::unordered_set<uint32_t> m_removed;
+};
+
+} // namespace ns3
+
+#endif /* DARY_HEAP_SCHEDULER_H */
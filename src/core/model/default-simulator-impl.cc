@@ -22,13 +22,17 @@
 #include "default-simulator-impl.h"
 #include "scheduler.h"
 #include "event-impl.h"
+#include "event-profiler.h"
 
 #include "ptr.h"
 #include "pointer.h"
 #include "assert.h"
 #include "log.h"
+#include "boolean.h"
+#include "uinteger.h"
 
 #include <cmath>
+#include <iostream>
 
 
 /**
@@ -53,6 +57,24 @@ DefaultSimulatorImpl::GetTypeId (void)
     .SetParent<SimulatorImpl> ()
     .SetGroupName ("Core")
     .AddConstructor<DefaultSimulatorImpl> ()
+    .AddAttribute ("ProfileInterval",
+                   "The interval of simulation time over which the depth of the event "
+                   "list is averaged when profiling.",
+                   TimeValue (Seconds (1)),
+                   MakeTimeAccessor (&DefaultSimulatorImpl::m_profileInterval),
+                   MakeTimeChecker (TimeStep (1)))
+    .AddAttribute ("ProfileTop",
+                   "The number of event types and of contexts reported when profiling.",
+                   UintegerValue (20),
+                   MakeUintegerAccessor (&DefaultSimulatorImpl::m_profileTop),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Profile",
+                   "Whether to profile the events executed and print the profile "
+                   "at Simulator::Destroy.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&DefaultSimulatorImpl::SetProfile,
+                                        &DefaultSimulatorImpl::GetProfile),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
@@ -72,13 +94,14 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentContext = Simulator::NO_CONTEXT;
   m_unscheduledEvents = 0;
   m_eventCount = 0;
-  m_eventsWithContextEmpty = true;
   m_main = SystemThread::Self ();
+  m_profiler = 0;
 }
 
 DefaultSimulatorImpl::~DefaultSimulatorImpl ()
 {
   NS_LOG_FUNCTION (this);
+  delete m_profiler;
 }
 
 void
@@ -93,12 +116,17 @@ DefaultSimulatorImpl::DoDispose (void)
       next.impl->Unref ();
     }
   m_events = 0;
+  SetProfile (false);
   SimulatorImpl::DoDispose ();
 }
 void
 DefaultSimulatorImpl::Destroy ()
 {
   NS_LOG_FUNCTION (this);
+  if (m_profiler != 0)
+    {
+      PrintProfile (std::cout);
+    }
   while (!m_destroyEvents.empty ())
     {
       Ptr<EventImpl> ev = m_destroyEvents.front ().PeekEventImpl ();
@@ -148,37 +176,68 @@ DefaultSimulatorImpl::ProcessOneEvent (void)
   m_currentTs = next.key.m_ts;
   m_currentContext = next.key.m_context;
   m_currentUid = next.key.m_uid;
-  next.impl->Invoke ();
+  if (m_profiler == 0)
+    {
+      next.impl->Invoke ();
+    }
+  else
+    {
+      // the event may disable profiling
+      EventProfiler *profiler = m_profiler;
+      profiler->BeginEvent ();
+      next.impl->Invoke ();
+      if (m_profiler == profiler)
+        {
+          profiler->EndEvent (next.impl, next.key.m_context, next.key.m_ts, m_unscheduledEvents);
+        }
+    }
   next.impl->Unref ();
 
   ProcessEventsWithContext ();
 }
 
+void
+DefaultSimulatorImpl::SetProfile (bool profile)
+{
+  NS_LOG_FUNCTION (this << profile);
+  if (profile && m_profiler == 0)
+    {
+      m_profiler = new EventProfiler (m_profileInterval, m_profileTop);
+    }
+  else if (!profile)
+    {
+      delete m_profiler;
+      m_profiler = 0;
+    }
+}
+
 bool
-DefaultSimulatorImpl::IsFinished (void) const
+DefaultSimulatorImpl::GetProfile (void) const
 {
-  return m_events->IsEmpty () || m_stop;
+  return m_profiler != 0;
 }
 
 void
-DefaultSimulatorImpl::ProcessEventsWithContext (void)
+DefaultSimulatorImpl::PrintProfile (std::ostream &os) const
 {
-  if (m_eventsWithContextEmpty)
+  NS_LOG_FUNCTION (this);
+  if (m_profiler != 0)
     {
-      return;
+      m_profiler->Print (os);
     }
+}
+
+bool
+DefaultSimulatorImpl::IsFinished (void) const
+{
+  return m_events->IsEmpty () || m_stop;
+}
 
-  // swap queues
-  EventsWithContext eventsWithContext;
-  {
-    CriticalSection cs (m_eventsWithContextMutex);
-    m_eventsWithContext.swap (eventsWithContext);
-    m_eventsWithContextEmpty = true;
-  }
-  while (!eventsWithContext.empty ())
+void
+DefaultSimulatorImpl::ProcessEventsWithContext (void)
+{
+  m_eventsWithContext.Drain ([this] (const EventWithContext & event)
     {
-      EventWithContext event = eventsWithContext.front ();
-      eventsWithContext.pop_front ();
       Scheduler::Event ev;
       ev.impl = event.event;
       ev.key.m_ts = m_currentTs + event.timestamp;
@@ -187,7 +246,7 @@ DefaultSimulatorImpl::ProcessEventsWithContext (void)
       m_uid++;
       m_unscheduledEvents++;
       m_events->Insert (ev);
-    }
+    });
 }
 
 void
@@ -270,11 +329,7 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
       // Current time added in ProcessEventsWithContext()
       ev.timestamp = delay.GetTimeStep ();
       ev.event = event;
-      {
-        CriticalSection cs (m_eventsWithContextMutex);
-        m_eventsWithContext.push_back (ev);
-        m_eventsWithContextEmpty = false;
-      }
+      m_eventsWithContext.Push (ev);
     }
 }
 
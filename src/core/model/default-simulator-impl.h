@@ -25,11 +25,13 @@
 #include "scheduler.h"
 #include "event-impl.h"
 #include "system-thread.h"
-#include "system-mutex.h"
+#include "mpsc-queue.h"
 
 #include "ptr.h"
+#include "nstime.h"
 
 #include <list>
+#include <ostream>
 
 /**
  * \file
@@ -39,10 +41,20 @@
 
 namespace ns3 {
 
+class EventProfiler;
+
 /**
  * \ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * The events executed can be profiled by setting the Profile attribute,
+ * e.g., from the environment with
+ * <tt>NS_ATTRIBUTE_DEFAULT='ns3::DefaultSimulatorImpl::Profile=true'</tt>,
+ * or at any time during the simulation. The number of events and the
+ * wall-clock time spent executing them, by type of event and by context,
+ * and the depth of the event list over time (see EventProfiler) are then
+ * printed by Simulator::Destroy().
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -79,9 +91,27 @@ public:
   virtual uint32_t GetContext (void) const;
   virtual uint64_t GetEventCount (void) const;
 
+  /**
+   * Print the profile of the events executed since profiling was enabled.
+   *
+   * \param [in,out] os The output stream.
+   */
+  void PrintProfile (std::ostream &os) const;
+
 private:
   virtual void DoDispose (void);
 
+  /**
+   * Enable or disable the profiling of the events.
+   *
+   * \param [in] profile Whether to profile the events.
+   */
+  void SetProfile (bool profile);
+  /**
+   * \returns Whether the events are profiled.
+   */
+  bool GetProfile (void) const;
+
   /** Process the next event. */
   void ProcessOneEvent (void);
   /** Move events from a different context into the main event queue. */
@@ -97,17 +127,12 @@ private:
     /** The event implementation. */
     EventImpl *event;
   };
-  /** Container type for the events from a different context. */
-  typedef std::list<struct EventWithContext> EventsWithContext;
-  /** The container of events from a different context. */
-  EventsWithContext m_eventsWithContext;
   /**
-   * Flag \c true if all events with context have been moved to the
-   * primary event queue.
+   * The events from a different context, scheduled by other threads.
+   * They are pushed without locking, and moved in a batch into the
+   * main event queue by the main thread.
    */
-  bool m_eventsWithContextEmpty;
-  /** Mutex to control access to the list of events with context. */
-  SystemMutex m_eventsWithContextMutex;
+  MpscQueue<EventWithContext> m_eventsWithContext;
 
   /** Container type for the events to run at Simulator::Destroy() */
   typedef std::list<EventId> DestroyEvents;
@@ -136,6 +161,13 @@ private:
 
   /** Main execution thread. */
   SystemThread::ThreadId m_main;
+
+  /** The profiler of the events, null if profiling is disabled. */
+  EventProfiler *m_profiler;
+  /** The interval over which the depth of the event list is profiled. */
+  Time m_profileInterval;
+  /** The number of event types and of contexts profiled. */
+  uint32_t m_profileTop;
 };
 
 } // namespace ns3
@@ -20,6 +20,10 @@
 
 #include "event-impl.h"
 #include "log.h"
+#include <algorithm>
+#include <mutex>
+#include <new>
+#include <vector>
 
 /**
  * \file
@@ -31,6 +35,258 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+namespace {
+
+/** Granularity of the sizes of the objects allocated by the pool. */
+const std::size_t EVENT_SIZE_STEP = 16;
+/** Number of size classes, hence the size of the largest pooled objects. */
+const std::size_t EVENT_SIZE_CLASSES = 16;
+/** Size of the slabs from which the objects are carved. */
+const std::size_t EVENT_SLAB_SIZE = 64 * 1024;
+/** Number of objects exchanged at once between a thread cache and the pool. */
+const std::size_t EVENT_BATCH_SIZE = 64;
+
+/**
+ * \param [in] size The size of an object.
+ * \returns The size class of the object.
+ */
+inline std::size_t
+SizeClass (std::size_t size)
+{
+  return (size + EVENT_SIZE_STEP - 1) / EVENT_SIZE_STEP - 1;
+}
+
+/**
+ * The process-wide pool of the free objects, shared by all the threads.
+ *
+ * The free objects are kept as arrays of pointers rather than linked
+ * through the objects themselves, so that batches of objects are moved
+ * without touching their (likely cold) memory. The pool is never
+ * destroyed, since events may be freed during the destruction of static
+ * objects.
+ */
+struct EventPool
+{
+  std::mutex mutex;                                //!< Protects the pool
+  std::vector<void *> free[EVENT_SIZE_CLASSES];    //!< The free objects of each size class
+  EventImpl::AllocatorStats stats;                 //!< Statistics flushed by the threads
+
+  /**
+   * Make sure that at least a batch of objects is free, carving a new
+   * slab if needed. The mutex must be held.
+   *
+   * \param [in] sizeClass The size class of the objects.
+   */
+  void Fill (std::size_t sizeClass);
+};
+
+void
+EventPool::Fill (std::size_t sizeClass)
+{
+  std::vector<void *> &objects = free[sizeClass];
+  if (objects.size () >= EVENT_BATCH_SIZE)
+    {
+      return;
+    }
+  std::size_t size = (sizeClass + 1) * EVENT_SIZE_STEP;
+  std::size_t n = EVENT_SLAB_SIZE / size;
+  char *slab = static_cast<char *> (::operator new (EVENT_SLAB_SIZE));
+  // hand out the objects in the order of their addresses
+  for (std::size_t i = n; i > 0; i--)
+    {
+      objects.push_back (slab + (i - 1) * size);
+    }
+  stats.slabs++;
+  stats.slabBytes += EVENT_SLAB_SIZE;
+}
+
+/**
+ * \returns The process-wide pool of the objects.
+ */
+EventPool &
+GetEventPool (void)
+{
+  // never deleted, see EventPool
+  static EventPool *pool = new EventPool ();
+  return *pool;
+}
+
+/**
+ * The free objects cached by a thread, which it allocates and frees
+ * without any locking.
+ *
+ * This structure is trivially destructible, so that it can still be
+ * checked by the events freed after the thread has released its cache.
+ */
+struct EventCache
+{
+  void *free[EVENT_SIZE_CLASSES][2 * EVENT_BATCH_SIZE]; //!< The free objects of each size class
+  std::size_t count[EVENT_SIZE_CLASSES];                //!< The number of free objects of each size class
+  uint64_t allocations;                                 //!< Allocations not yet flushed to the pool
+  uint64_t deallocations;                               //!< Deallocations not yet flushed to the pool
+  uint64_t large;                                       //!< Large allocations not yet flushed to the pool
+  bool registered;                                      //!< Whether the EventCacheReleaser is registered
+  bool released;                                        //!< Whether the objects were returned to the pool
+
+  /**
+   * Flush the statistics to the pool, whose mutex must be held.
+   *
+   * \param [in,out] pool The pool.
+   */
+  void FlushStats (EventPool &pool);
+};
+
+/** The cache of the thread. */
+thread_local EventCache g_eventCache;
+
+void
+EventCache::FlushStats (EventPool &pool)
+{
+  pool.stats.allocations += allocations;
+  pool.stats.deallocations += deallocations;
+  pool.stats.large += large;
+  allocations = 0;
+  deallocations = 0;
+  large = 0;
+}
+
+/** Returns the objects cached by a thread to the pool when the thread exits. */
+struct EventCacheReleaser
+{
+  /** Make sure that the releaser of the thread is constructed. */
+  void Register (void);
+  /** Return the objects cached by the thread to the pool. */
+  ~EventCacheReleaser ();
+};
+
+/** The releaser of the cache of the thread. */
+thread_local EventCacheReleaser g_eventCacheReleaser;
+
+void
+EventCacheReleaser::Register (void)
+{
+  g_eventCache.registered = true;
+}
+
+EventCacheReleaser::~EventCacheReleaser ()
+{
+  EventCache &cache = g_eventCache;
+  EventPool &pool = GetEventPool ();
+  std::lock_guard<std::mutex> lock (pool.mutex);
+  for (std::size_t i = 0; i < EVENT_SIZE_CLASSES; i++)
+    {
+      pool.free[i].insert (pool.free[i].end (), cache.free[i], cache.free[i] + cache.count[i]);
+      cache.count[i] = 0;
+    }
+  cache.FlushStats (pool);
+  cache.released = true;
+}
+
+} // unnamed namespace
+
+void *
+EventImpl::operator new (std::size_t size)
+{
+  EventCache &cache = g_eventCache;
+  if (size > EVENT_SIZE_CLASSES * EVENT_SIZE_STEP || cache.released)
+    {
+      void *p;
+      EventPool &pool = GetEventPool ();
+      std::lock_guard<std::mutex> lock (pool.mutex);
+      if (size > EVENT_SIZE_CLASSES * EVENT_SIZE_STEP)
+        {
+          p = ::operator new (size);
+          pool.stats.large++;
+        }
+      else
+        {
+          std::size_t sizeClass = SizeClass (size);
+          pool.Fill (sizeClass);
+          p = pool.free[sizeClass].back ();
+          pool.free[sizeClass].pop_back ();
+        }
+      pool.stats.allocations++;
+      return p;
+    }
+  std::size_t sizeClass = SizeClass (size);
+  if (cache.count[sizeClass] == 0)
+    {
+      if (!cache.registered)
+        {
+          g_eventCacheReleaser.Register ();
+        }
+      EventPool &pool = GetEventPool ();
+      std::lock_guard<std::mutex> lock (pool.mutex);
+      pool.Fill (sizeClass);
+      std::vector<void *> &objects = pool.free[sizeClass];
+      std::copy (objects.end () - EVENT_BATCH_SIZE, objects.end (), cache.free[sizeClass]);
+      objects.resize (objects.size () - EVENT_BATCH_SIZE);
+      cache.count[sizeClass] = EVENT_BATCH_SIZE;
+      cache.FlushStats (pool);
+    }
+  cache.allocations++;
+  return cache.free[sizeClass][--cache.count[sizeClass]];
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  EventCache &cache = g_eventCache;
+  if (size > EVENT_SIZE_CLASSES * EVENT_SIZE_STEP || cache.released || !cache.registered)
+    {
+      // the objects allocated by the pool are cached only by the threads
+      // that registered their releaser
+      EventPool &pool = GetEventPool ();
+      std::lock_guard<std::mutex> lock (pool.mutex);
+      if (size > EVENT_SIZE_CLASSES * EVENT_SIZE_STEP)
+        {
+          ::operator delete (p);
+        }
+      else
+        {
+          pool.free[SizeClass (size)].push_back (p);
+        }
+      pool.stats.deallocations++;
+      return;
+    }
+  std::size_t sizeClass = SizeClass (size);
+  if (cache.count[sizeClass] == 2 * EVENT_BATCH_SIZE)
+    {
+      // return the oldest batch of objects to the pool
+      EventPool &pool = GetEventPool ();
+      std::lock_guard<std::mutex> lock (pool.mutex);
+      void **objects = cache.free[sizeClass];
+      pool.free[sizeClass].insert (pool.free[sizeClass].end (), objects, objects + EVENT_BATCH_SIZE);
+      std::copy (objects + EVENT_BATCH_SIZE, objects + 2 * EVENT_BATCH_SIZE, objects);
+      cache.count[sizeClass] = EVENT_BATCH_SIZE;
+      cache.FlushStats (pool);
+    }
+  cache.free[sizeClass][cache.count[sizeClass]++] = p;
+  cache.deallocations++;
+}
+
+EventImpl::AllocatorStats
+EventImpl::GetAllocatorStats (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  EventPool &pool = GetEventPool ();
+  std::lock_guard<std::mutex> lock (pool.mutex);
+  g_eventCache.FlushStats (pool);
+  return pool.stats;
+}
+
+std::ostream &
+operator << (std::ostream &os, const EventImpl::AllocatorStats &stats)
+{
+  os << "allocations=" << stats.allocations
+     << " deallocations=" << stats.deallocations
+     << " live=" << stats.allocations - stats.deallocations
+     << " large=" << stats.large
+     << " slabs=" << stats.slabs
+     << " slabBytes=" << stats.slabBytes;
+  return os;
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
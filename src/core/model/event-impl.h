@@ -21,6 +21,8 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
+#include <ostream>
 #include "simple-ref-count.h"
 
 /**
@@ -40,10 +42,60 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * Events are allocated from a pool rather than from the general purpose
+ * heap. Objects of up to 256 bytes, which include all the events created
+ * by MakeEvent() together with their bound arguments, are carved out of
+ * large slabs in size classes of 16 bytes. Each thread keeps a cache of
+ * free objects for each size class, which is refilled from (or returned
+ * to) the process-wide pool in batches, so that creating and destroying
+ * an event usually amounts to popping and pushing a free list. The memory
+ * of a freed event is recycled as soon as its last reference is released,
+ * i.e., when it has been invoked, or removed from the event list after
+ * being cancelled, and no EventId refers to it any longer.
+ *
+ * The slabs are never returned to the system: they are kept to be reused
+ * by the following simulations.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
 public:
+  /** Statistics of the allocator of the events. */
+  struct AllocatorStats
+  {
+    uint64_t allocations;   //!< Number of events allocated
+    uint64_t deallocations; //!< Number of events freed
+    uint64_t large;         //!< Number of events too large for the pool
+    uint64_t slabs;         //!< Number of slabs allocated by the pool
+    uint64_t slabBytes;     //!< Size of the memory held by the pool, in bytes
+  };
+
+  /**
+   * Get the statistics of the allocator of the events.
+   *
+   * The counts of the calling thread are exact; the counts of the other
+   * threads are included up to the last time they exchanged a batch
+   * of objects with the pool.
+   *
+   * \returns The statistics of the allocator.
+   */
+  static AllocatorStats GetAllocatorStats (void);
+
+  /**
+   * Allocate the memory of an event.
+   *
+   * \param [in] size The size of the event.
+   * \returns The memory of the event.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Free the memory of an event.
+   *
+   * \param [in] p The memory of the event.
+   * \param [in] size The size of the event.
+   */
+  static void operator delete (void *p, std::size_t size);
+
   /** Default constructor. */
   EventImpl ();
   /** Destructor. */
@@ -79,6 +131,16 @@ private:
   bool m_cancel;  /**< Has this event been cancelled. */
 };
 
+/**
+ * \ingroup events
+ * Output streamer for the statistics of the allocator of the events.
+ *
+ * \param [in,out] os The output stream.
+ * \param [in] stats The statistics.
+ * \returns The output stream.
+ */
+std::ostream & operator << (std::ostream &os, const EventImpl::AllocatorStats &stats);
+
 } // namespace ns3
 
 #endif /* EVENT_IMPL_H */
@@ -0,0 +1,279 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-profiler.h"
+#include "event-impl.h"
+#include "simulator.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventProfiler");
+
+/**
+ * \ingroup simulator
+ * The maximum number of intervals whose depth of the event list is
+ * stored: beyond, consecutive intervals are merged.
+ */
+static const std::size_t MAX_DEPTH_INTERVALS = 4096;
+/**
+ * \ingroup simulator
+ * The maximum number of rows of the table of the depth of the event list.
+ */
+static const std::size_t MAX_DEPTH_ROWS = 20;
+
+EventProfiler::EventProfiler (Time interval, uint32_t top)
+  : m_interval (std::max<int64_t> (interval.GetTimeStep (), 1)),
+    m_top (top),
+    m_lastType (0),
+    m_lastTypeStats (0)
+{
+  NS_LOG_FUNCTION (this << interval << top);
+}
+
+void
+EventProfiler::EndEvent (const EventImpl *event, uint32_t context, uint64_t ts, uint64_t depth)
+{
+  uint64_t duration = std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now () - m_begin).count ();
+
+  // consecutive events are often of the same type
+  const std::type_info *type = &typeid (*event);
+  if (type != m_lastType)
+    {
+      m_lastType = type;
+      m_lastTypeStats = &m_types[type];
+    }
+  m_lastTypeStats->count++;
+  m_lastTypeStats->duration += duration;
+
+  Stats &contextStats = m_contexts[context];
+  contextStats.count++;
+  contextStats.duration += duration;
+
+  uint64_t interval = ts / m_interval;
+  while (interval >= MAX_DEPTH_INTERVALS)
+    {
+      // merge consecutive intervals to bound the memory used
+      for (std::size_t i = 0; i < m_depths.size (); i += 2)
+        {
+          DepthStats merged = m_depths[i];
+          if (i + 1 < m_depths.size ())
+            {
+              merged.count += m_depths[i + 1].count;
+              merged.sum += m_depths[i + 1].sum;
+              merged.max = std::max (merged.max, m_depths[i + 1].max);
+            }
+          m_depths[i / 2] = merged;
+        }
+      m_depths.resize ((m_depths.size () + 1) / 2);
+      m_interval *= 2;
+      interval = ts / m_interval;
+    }
+  if (interval >= m_depths.size ())
+    {
+      m_depths.resize (interval + 1, DepthStats {0, 0, 0});
+    }
+  DepthStats &depthStats = m_depths[interval];
+  depthStats.count++;
+  depthStats.sum += depth;
+  depthStats.max = std::max (depthStats.max, depth);
+}
+
+std::string
+EventProfiler::GetTypeName (const std::type_info &type)
+{
+  std::string name = type.name ();
+#if (__GNUC__ >= 3)
+  int status;
+  char *demangled = abi::__cxa_demangle (name.c_str (), NULL, NULL, &status);
+  if (status == 0)
+    {
+      name = demangled;
+    }
+  std::free (demangled);
+#endif
+  // the events created by MakeEvent are local classes of MakeEvent,
+  // whose first parameter is the function or member function called:
+  // keep its type only
+  std::string prefix = "ns3::MakeEvent";
+  if (name.compare (0, prefix.size (), prefix) != 0)
+    {
+      return name;
+    }
+  std::size_t i = prefix.size ();
+  int level = 0;
+  // skip the template arguments
+  for (; i < name.size (); i++)
+    {
+      if (name[i] == '<')
+        {
+          level++;
+        }
+      else if (name[i] == '>')
+        {
+          level--;
+        }
+      else if (level == 0)
+        {
+          break;
+        }
+    }
+  if (i == name.size () || name[i] != '(')
+    {
+      return name;
+    }
+  std::size_t first = ++i;
+  for (; i < name.size (); i++)
+    {
+      switch (name[i])
+        {
+        case '<':
+        case '(':
+          level++;
+          break;
+        case '>':
+        case ')':
+          if (level == 0)
+            {
+              return name.substr (first, i - first);
+            }
+          level--;
+          break;
+        case ',':
+          if (level == 0)
+            {
+              return name.substr (first, i - first);
+            }
+          break;
+        default:
+          break;
+        }
+    }
+  return name;
+}
+
+void
+EventProfiler::PrintTable (std::ostream &os, std::string title,
+                           std::vector<std::pair<std::string, Stats> > rows) const
+{
+  uint64_t total = 0;
+  for (const auto & row : rows)
+    {
+      total += row.second.duration;
+    }
+  std::sort (rows.begin (), rows.end (),
+             [] (const std::pair<std::string, Stats> &a, const std::pair<std::string, Stats> &b)
+             {
+               return a.second.duration > b.second.duration
+                      || (a.second.duration == b.second.duration && a.first < b.first);
+             });
+
+  os << title << " (" << std::min<std::size_t> (rows.size (), m_top) << " of " << rows.size ()
+     << ", by decreasing wall-clock time):" << std::endl
+     << std::setw (14) << "events"
+     << std::setw (12) << "time (ms)"
+     << std::setw (8) << "share"
+     << std::setw (12) << "ns/event"
+     << "  " << title << std::endl;
+  for (std::size_t i = 0; i < rows.size () && i < m_top; i++)
+    {
+      const Stats &stats = rows[i].second;
+      os << std::setw (14) << stats.count
+         << std::setw (12) << std::fixed << std::setprecision (1) << stats.duration / 1e6
+         << std::setw (7) << (total > 0 ? 100.0 * stats.duration / total : 0.0) << "%"
+         << std::setw (12) << (stats.count > 0 ? stats.duration / stats.count : 0)
+         << "  " << rows[i].first << std::endl;
+    }
+  os.unsetf (std::ios_base::floatfield);
+  os << std::setprecision (6);
+}
+
+void
+EventProfiler::Print (std::ostream &os) const
+{
+  uint64_t count = 0;
+  uint64_t duration = 0;
+  for (const auto & context : m_contexts)
+    {
+      count += context.second.count;
+      duration += context.second.duration;
+    }
+  os << "Event profile: " << count << " events executed in " << duration / 1e9 << " s";
+  if (count > 0)
+    {
+      os << " (" << duration / count << " ns per event)";
+    }
+  os << std::endl;
+
+  // merge the type_info instances of the same type
+  std::map<std::string, Stats> types;
+  for (const auto & type : m_types)
+    {
+      Stats &stats = types.insert (std::make_pair (GetTypeName (*type.first), Stats {0, 0})).first->second;
+      stats.count += type.second.count;
+      stats.duration += type.second.duration;
+    }
+  PrintTable (os, "event type", std::vector<std::pair<std::string, Stats> > (types.begin (), types.end ()));
+
+  std::vector<std::pair<std::string, Stats> > contexts;
+  for (const auto & context : m_contexts)
+    {
+      contexts.push_back (std::make_pair (context.first == Simulator::NO_CONTEXT ?
+                                          std::string ("none") : std::to_string (context.first),
+                                          context.second));
+    }
+  PrintTable (os, "context", contexts);
+
+  // merge consecutive intervals to print at most MAX_DEPTH_ROWS rows
+  std::size_t merge = (m_depths.size () + MAX_DEPTH_ROWS - 1) / MAX_DEPTH_ROWS;
+  os << "event list depth:" << std::endl
+     << std::setw (14) << "from (s)"
+     << std::setw (14) << "events"
+     << std::setw (12) << "mean depth"
+     << std::setw (12) << "max depth" << std::endl;
+  for (std::size_t i = 0; i < m_depths.size (); i += merge)
+    {
+      DepthStats stats = {0, 0, 0};
+      for (std::size_t j = i; j < i + merge && j < m_depths.size (); j++)
+        {
+          stats.count += m_depths[j].count;
+          stats.sum += m_depths[j].sum;
+          stats.max = std::max (stats.max, m_depths[j].max);
+        }
+      os << std::setw (14) << TimeStep (i * m_interval).GetSeconds ()
+         << std::setw (14) << stats.count
+         << std::setw (12) << (stats.count > 0 ? stats.sum / stats.count : 0)
+         << std::setw (12) << stats.max << std::endl;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include "nstime.h"
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ *
+ * Aggregate statistics of the events executed by a simulator
+ * implementation: the number of events and the wall-clock time spent
+ * executing them, by type of event and by context, and the depth of the
+ * event list over the simulation time.
+ *
+ * The type of an event is the C++ type of its EventImpl, i.e., for the
+ * events created by MakeEvent(), the type of the function or of the
+ * member function called by the event (hence, its class and signature):
+ * the member functions of a class with the same signature are not told
+ * apart. Unlike DesMetrics, which writes every event, the memory and time
+ * used by the profiler do not grow with the number of events: the
+ * overhead is two reads of the wall clock and two table lookups per
+ * event.
+ */
+class EventProfiler
+{
+public:
+  /**
+   * Constructor.
+   *
+   * \param [in] interval The interval of simulation time over which the
+   *             depth of the event list is averaged.
+   * \param [in] top The number of types and of contexts reported, by
+   *             decreasing wall-clock time.
+   */
+  EventProfiler (Time interval, uint32_t top);
+
+  /** Called before an event is executed. */
+  void BeginEvent (void)
+  {
+    m_begin = Clock::now ();
+  }
+  /**
+   * Called after an event is executed.
+   *
+   * \param [in] event The event.
+   * \param [in] context The context of the event.
+   * \param [in] ts The timestamp of the event.
+   * \param [in] depth The number of events left in the event list.
+   */
+  void EndEvent (const EventImpl *event, uint32_t context, uint64_t ts, uint64_t depth);
+  /**
+   * Print the summary tables.
+   *
+   * \param [in,out] os The output stream.
+   */
+  void Print (std::ostream &os) const;
+
+private:
+  /** The clock measuring the time spent executing events. */
+  typedef std::chrono::steady_clock Clock;
+
+  /** The statistics of a type of event or of a context. */
+  struct Stats
+  {
+    uint64_t count;    //!< The number of events
+    uint64_t duration; //!< The wall-clock time spent executing the events, in ns
+  };
+
+  /** The depth of the event list over an interval of simulation time. */
+  struct DepthStats
+  {
+    uint64_t count;    //!< The number of events executed
+    uint64_t sum;      //!< The sum of the depths after each event
+    uint64_t max;      //!< The maximum depth
+  };
+
+  /**
+   * \param [in] type The C++ type of an event.
+   * \returns A readable name of the type, i.e., the function
+   * (pointer) type for the events created by MakeEvent().
+   */
+  static std::string GetTypeName (const std::type_info &type);
+
+  /**
+   * Print the first rows of a table of statistics, by decreasing time.
+   *
+   * \param [in,out] os The output stream.
+   * \param [in] title The title of the table.
+   * \param [in] rows The name and statistics of each row.
+   */
+  void PrintTable (std::ostream &os, std::string title,
+                   std::vector<std::pair<std::string, Stats> > rows) const;
+
+  int64_t m_interval;                //!< The depth averaging interval, in time steps
+  uint32_t m_top;                    //!< The number of rows reported
+  Clock::time_point m_begin;         //!< The start of the current event
+  /**
+   * The statistics of each type of event. Types are compared by address
+   * (a type may have several type_info instances in different libraries,
+   * which are merged in the report).
+   */
+  std::unordered_map<const std::type_info *, Stats> m_types;
+  const std::type_info *m_lastType;  //!< The type of the last event
+  Stats *m_lastTypeStats;            //!< The statistics of the type of the last event
+  std::unordered_map<uint32_t, Stats> m_contexts; //!< The statistics of each context
+  std::vector<DepthStats> m_depths;  //!< The depth of the event list in each interval
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MpscQueue declaration and template implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * A lock-free, unbounded, multiple producer single consumer queue.
+ *
+ * Any number of threads may Push() items concurrently; a single thread
+ * (the consumer) may call Drain() and IsEmpty(). The items are pushed
+ * on an intrusive stack with a compare-and-swap, and the consumer takes
+ * all of them at once with an atomic exchange, then reverses them, so
+ * that the items pushed by each producer are drained in the order in
+ * which they were pushed. Since the consumer never pops a single item,
+ * the queue is not subject to the ABA problem.
+ *
+ * \tparam T \explicit The type of the items.
+ */
+template <typename T>
+class MpscQueue
+{
+public:
+  MpscQueue ();
+  /** Destructor, discarding the items left. */
+  ~MpscQueue ();
+
+  /**
+   * Push an item. This may be called by any thread.
+   *
+   * \param [in] item The item.
+   */
+  void Push (const T &item);
+  /**
+   * Check whether the queue is empty, without locking. An item being
+   * pushed concurrently may or may not be seen.
+   *
+   * \returns \c true if no item was pushed since the last Drain().
+   */
+  bool IsEmpty (void) const;
+  /**
+   * Remove all the items pushed so far, calling a function on each of
+   * them. This must be called by the consumer thread only.
+   *
+   * \tparam F \deduced The type of the function, taking a <tt>T &</tt>.
+   * \param [in] f The function.
+   * \returns The number of items removed.
+   */
+  template <typename F>
+  std::size_t Drain (F f);
+
+private:
+  /** An item of the queue. */
+  struct Node
+  {
+    T item;     //!< The item
+    Node *next; //!< The item pushed before this one
+  };
+
+  /** Copy constructor, deleted. */
+  MpscQueue (const MpscQueue &) = delete;
+  /**
+   * Assignment operator, deleted.
+   * \returns This queue.
+   */
+  MpscQueue & operator = (const MpscQueue &) = delete;
+
+  /** The last item pushed. */
+  std::atomic<Node *> m_head;
+};
+
+} // namespace ns3
+
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3 {
+
+template <typename T>
+MpscQueue<T>::MpscQueue ()
+  : m_head (nullptr)
+{
+}
+
+template <typename T>
+MpscQueue<T>::~MpscQueue ()
+{
+  Node *node = m_head.exchange (nullptr, std::memory_order_acquire);
+  while (node != nullptr)
+    {
+      Node *next = node->next;
+      delete node;
+      node = next;
+    }
+}
+
+template <typename T>
+void
+MpscQueue<T>::Push (const T &item)
+{
+  Node *node = new Node {item, m_head.load (std::memory_order_relaxed)};
+  while (!m_head.compare_exchange_weak (node->next, node,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed))
+    {
+    }
+}
+
+template <typename T>
+bool
+MpscQueue<T>::IsEmpty (void) const
+{
+  return m_head.load (std::memory_order_relaxed) == nullptr;
+}
+
+template <typename T>
+template <typename F>
+std::size_t
+MpscQueue<T>::Drain (F f)
+{
+  if (IsEmpty ())
+    {
+      return 0;
+    }
+  Node *node = m_head.exchange (nullptr, std::memory_order_acquire);
+  // reverse the stack into the push order
+  Node *first = nullptr;
+  while (node != nullptr)
+    {
+      Node *next = node->next;
+      node->next = first;
+      first = node;
+      node = next;
+    }
+  std::size_t n = 0;
+  while (first != nullptr)
+    {
+      Node *next = first->next;
+      f (first->item);
+      delete first;
+      first = next;
+      n++;
+    }
+  return n;
+}
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
@@ -0,0 +1,761 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+#include "simulator.h"
+#include "map-scheduler.h"
+#include "nstime.h"
+
+#include "assert.h"
+#include "log.h"
+#include "fatal-error.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+namespace {
+
+/**
+ * \ingroup simulator
+ * The partition whose events are executed by the calling thread, or
+ * null outside of MultithreadedSimulatorImpl::Run (e.g., in the main
+ * program), where the events can be scheduled in any partition.
+ */
+thread_local void *g_currentPartition = 0;
+
+/** A timestamp larger than all the event timestamps. */
+const uint64_t MAX_TS = std::numeric_limits<uint64_t>::max ();
+
+} // unnamed namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Core")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("Lookahead",
+                   "The minimum delay of the events scheduled for a context "
+                   "of another partition, usually the minimum propagation delay "
+                   "between the nodes of different partitions. It must be "
+                   "strictly positive if there are several partitions.",
+                   TimeValue (Time (0)),
+                   MakeTimeAccessor (&MultithreadedSimulatorImpl::m_lookahead),
+                   MakeTimeChecker (Time (0)))
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+  : m_nPartitions (1),
+    m_started (false),
+    m_stop (false),
+    m_done (false),
+    m_windowEnd (0),
+    m_runs (0),
+    m_exit (false)
+{
+  NS_LOG_FUNCTION (this);
+  m_global = new Partition ();
+  m_global->index = 0;
+  // uids are allocated from 4, as in DefaultSimulatorImpl
+  m_global->uid = 4;
+  m_global->currentUid = 0;
+  m_global->currentTs = 0;
+  m_global->currentContext = Simulator::NO_CONTEXT;
+  m_global->eventCount = 0;
+  m_global->stop = false;
+  m_schedulerFactory.SetTypeId (MapScheduler::GetTypeId ());
+  m_global->events = m_schedulerFactory.Create<Scheduler> ();
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_threads.empty ());
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  {
+    std::unique_lock<std::mutex> lock (m_threadsMutex);
+    m_exit = true;
+  }
+  m_threadsCondition.notify_all ();
+  for (auto & thread : m_threads)
+    {
+      thread.join ();
+    }
+  m_threads.clear ();
+
+  m_partitions.push_back (m_global);
+  for (auto partition : m_partitions)
+    {
+      while (!partition->events->IsEmpty ())
+        {
+          Scheduler::Event next = partition->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      for (auto & outbox : partition->outbox)
+        {
+          for (auto & ev : outbox)
+            {
+              ev.impl->Unref ();
+            }
+        }
+      delete partition;
+    }
+  m_partitions.clear ();
+  m_global = 0;
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (true)
+    {
+      Ptr<EventImpl> ev;
+      {
+        std::unique_lock<std::mutex> lock (m_destroyEventsMutex);
+        if (m_destroyEvents.empty ())
+          {
+            break;
+          }
+        ev = m_destroyEvents.front ().PeekEventImpl ();
+        m_destroyEvents.pop_front ();
+      }
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  NS_ASSERT_MSG (g_currentPartition == 0, "The scheduler cannot be changed by an event");
+  m_schedulerFactory = schedulerFactory;
+  std::vector<Partition *> partitions = m_partitions;
+  partitions.push_back (m_global);
+  for (auto partition : partitions)
+    {
+      Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+      while (!partition->events->IsEmpty ())
+        {
+          scheduler->Insert (partition->events->RemoveNext ());
+        }
+      partition->events = scheduler;
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetPartition (uint32_t context, uint32_t partition)
+{
+  NS_LOG_FUNCTION (this << context << partition);
+  if (m_started)
+    {
+      NS_FATAL_ERROR ("The partitions must be set before the simulation starts");
+    }
+  NS_ASSERT (context != Simulator::NO_CONTEXT);
+  if (context >= m_contextPartition.size ())
+    {
+      m_contextPartition.resize (context + 1, 0);
+    }
+  m_contextPartition[context] = partition;
+  m_nPartitions = std::max (m_nPartitions, partition + 1);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetNPartitions (void) const
+{
+  return m_nPartitions;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition (uint32_t context) const
+{
+  if (context < m_contextPartition.size ())
+    {
+      return m_contextPartition[context];
+    }
+  return 0;
+}
+
+Time
+MultithreadedSimulatorImpl::GetLookahead (void) const
+{
+  return m_lookahead;
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetCurrentPartition (void) const
+{
+  return static_cast<Partition *> (g_currentPartition);
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetPartitionOf (uint32_t context) const
+{
+  if (!m_started || context == Simulator::NO_CONTEXT)
+    {
+      return m_global;
+    }
+  return m_partitions[GetPartition (context)];
+}
+
+void
+MultithreadedSimulatorImpl::Insert (Partition *partition, Scheduler::Event &ev)
+{
+  ev.key.m_uid = partition->uid;
+  partition->uid++;
+  partition->events->Insert (ev);
+}
+
+void
+MultithreadedSimulatorImpl::Start (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t i = 0; i < m_nPartitions; i++)
+    {
+      Partition *partition = new Partition ();
+      partition->index = i;
+      partition->events = m_schedulerFactory.Create<Scheduler> ();
+      // keep the uids unique, so that the events scheduled so far
+      // keep their order in their new partition
+      partition->uid = m_global->uid;
+      partition->currentUid = 0;
+      partition->currentTs = m_global->currentTs;
+      partition->currentContext = Simulator::NO_CONTEXT;
+      partition->eventCount = 0;
+      partition->stop = false;
+      partition->outbox.resize (m_nPartitions + 1);
+      m_partitions.push_back (partition);
+    }
+  m_started = true;
+
+  // move the events with a context to their partition
+  Ptr<Scheduler> events = m_global->events;
+  m_global->events = m_schedulerFactory.Create<Scheduler> ();
+  while (!events->IsEmpty ())
+    {
+      Scheduler::Event ev = events->RemoveNext ();
+      GetPartitionOf (ev.key.m_context)->events->Insert (ev);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::StartThreads (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (uint32_t i = 1; i < m_nPartitions; i++)
+    {
+      m_threads.push_back (std::thread (&MultithreadedSimulatorImpl::ThreadLoop, this, i));
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ThreadLoop (uint32_t index)
+{
+  NS_LOG_FUNCTION (this << index);
+  uint64_t runs = 0;
+  while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock (m_threadsMutex);
+        m_threadsCondition.wait (lock, [this, runs] { return m_exit || m_runs != runs; });
+        if (m_exit)
+          {
+            return;
+          }
+        runs = m_runs;
+      }
+      RunPartition (index);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (g_currentPartition == 0, "Simulator::Run cannot be called by an event");
+  if (!m_started)
+    {
+      Start ();
+    }
+  if (m_nPartitions > 1 && m_lookahead <= Time (0))
+    {
+      NS_FATAL_ERROR ("The lookahead must be strictly positive with " << m_nPartitions << " partitions");
+    }
+  m_stop = false;
+  m_done = false;
+  for (auto partition : m_partitions)
+    {
+      partition->stop = false;
+    }
+  m_barrier.Reset (m_nPartitions);
+  if (m_threads.empty ())
+    {
+      StartThreads ();
+    }
+  {
+    std::unique_lock<std::mutex> lock (m_threadsMutex);
+    m_runs++;
+  }
+  m_threadsCondition.notify_all ();
+
+  RunPartition (0);
+
+  // the main program carries on from the latest event executed
+  for (auto partition : m_partitions)
+    {
+      m_global->currentTs = std::max (m_global->currentTs, partition->currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunPartition (uint32_t index)
+{
+  Partition *partition = m_partitions[index];
+  while (true)
+    {
+      ReceiveEvents (partition);
+      m_barrier.Wait ();
+      if (index == 0)
+        {
+          Coordinate ();
+        }
+      m_barrier.Wait ();
+      if (m_done)
+        {
+          break;
+        }
+      g_currentPartition = partition;
+      ProcessWindow (partition);
+      g_currentPartition = 0;
+      m_barrier.Wait ();
+    }
+  // make sure that all the threads left the loop before the next run
+  m_barrier.Wait ();
+}
+
+void
+MultithreadedSimulatorImpl::ReceiveEvents (Partition *partition)
+{
+  // the order of the senders is fixed, for the simulation to be deterministic
+  for (auto sender : m_partitions)
+    {
+      for (auto & ev : sender->outbox[partition->index])
+        {
+          Insert (partition, ev);
+        }
+      sender->outbox[partition->index].clear ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Coordinate (void)
+{
+  for (auto sender : m_partitions)
+    {
+      for (auto & ev : sender->outbox[m_nPartitions])
+        {
+          Insert (m_global, ev);
+        }
+      sender->outbox[m_nPartitions].clear ();
+    }
+
+  g_currentPartition = m_global;
+  while (true)
+    {
+      if (m_stop)
+        {
+          m_done = true;
+          break;
+        }
+      uint64_t tMin = MAX_TS;
+      for (auto partition : m_partitions)
+        {
+          if (!partition->events->IsEmpty ())
+            {
+              tMin = std::min (tMin, partition->events->PeekNext ().key.m_ts);
+            }
+        }
+      uint64_t tGlobal = m_global->events->IsEmpty () ? MAX_TS : m_global->events->PeekNext ().key.m_ts;
+      if (tMin == MAX_TS && tGlobal == MAX_TS)
+        {
+          m_done = true;
+          break;
+        }
+      if (tGlobal <= tMin)
+        {
+          // the global events are executed before the events of the
+          // partitions with the same timestamp
+          Invoke (m_global, m_global->events->RemoveNext ());
+          continue;
+        }
+      m_windowEnd = tGlobal;
+      if (m_nPartitions > 1)
+        {
+          uint64_t lookahead = m_lookahead.GetTimeStep ();
+          if (tMin < MAX_TS - lookahead)
+            {
+              m_windowEnd = std::min (m_windowEnd, tMin + lookahead);
+            }
+        }
+      break;
+    }
+  g_currentPartition = 0;
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow (Partition *partition)
+{
+  while (!partition->events->IsEmpty () && !partition->stop
+         && partition->events->PeekNext ().key.m_ts < m_windowEnd)
+    {
+      Invoke (partition, partition->events->RemoveNext ());
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Invoke (Partition *partition, const Scheduler::Event &next)
+{
+  NS_ASSERT (next.key.m_ts >= partition->currentTs);
+  partition->eventCount++;
+  partition->currentTs = next.key.m_ts;
+  partition->currentContext = next.key.m_context;
+  partition->currentUid = next.key.m_uid;
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  if (!m_global->events->IsEmpty ())
+    {
+      return false;
+    }
+  for (auto partition : m_partitions)
+    {
+      if (!partition->events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  Partition *current = GetCurrentPartition ();
+  if (current != 0 && current != m_global)
+    {
+      // stop this partition now, the others at the end of the window
+      current->stop = true;
+    }
+  m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  Simulator::Schedule (delay, &Simulator::Stop);
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+  Partition *current = GetCurrentPartition ();
+  if (current == 0)
+    {
+      current = m_global;
+    }
+  Time tAbsolute = delay + TimeStep (current->currentTs);
+
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
+  ev.key.m_context = current->currentContext;
+  Insert (current, ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+  Partition *current = GetCurrentPartition ();
+  Partition *target = GetPartitionOf (context);
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_context = context;
+
+  if (current == 0 || current == m_global)
+    {
+      // the partitions are not running
+      ev.key.m_ts = (uint64_t) (delay + TimeStep (m_global->currentTs)).GetTimeStep ();
+      Insert (target, ev);
+    }
+  else if (current == target)
+    {
+      ev.key.m_ts = (uint64_t) (delay + TimeStep (current->currentTs)).GetTimeStep ();
+      Insert (current, ev);
+    }
+  else if (m_nPartitions == 1)
+    {
+      // a global event: end the window before it
+      ev.key.m_ts = (uint64_t) (delay + TimeStep (current->currentTs)).GetTimeStep ();
+      Insert (m_global, ev);
+      m_windowEnd = std::min (m_windowEnd, ev.key.m_ts);
+    }
+  else
+    {
+      if (delay < m_lookahead)
+        {
+          NS_FATAL_ERROR ("Event scheduled for context " << context << " of another partition with delay "
+                          << delay << ", less than the lookahead " << m_lookahead);
+        }
+      ev.key.m_ts = (uint64_t) (delay + TimeStep (current->currentTs)).GetTimeStep ();
+      // the uid is allocated by the target partition when receiving the event
+      ev.key.m_uid = 0;
+      current->outbox[target == m_global ? m_nPartitions : target->index].push_back (ev);
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  return Schedule (Time (0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  std::unique_lock<std::mutex> lock (m_destroyEventsMutex);
+  EventId id (Ptr<EventImpl> (event, false), Now ().GetTimeStep (), 0xffffffff, 2);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  Partition *current = GetCurrentPartition ();
+  return TimeStep (current == 0 ? m_global->currentTs : current->currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs ()) - Now ();
+    }
+}
+
+MultithreadedSimulatorImpl::Partition *
+MultithreadedSimulatorImpl::GetOwner (const EventId &id) const
+{
+  Partition *owner = GetPartitionOf (id.GetContext ());
+  Partition *current = GetCurrentPartition ();
+  if (current != 0 && current != m_global && current != owner)
+    {
+      NS_FATAL_ERROR ("The events of context " << id.GetContext () << " can only be accessed from their partition");
+    }
+  return owner;
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      std::unique_lock<std::mutex> lock (m_destroyEventsMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  GetOwner (id)->events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      std::unique_lock<std::mutex> lock (m_destroyEventsMutex);
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  if (id.PeekEventImpl () == 0)
+    {
+      return true;
+    }
+  Partition *owner = GetOwner (id);
+  if (id.GetTs () < owner->currentTs
+      || (id.GetTs () == owner->currentTs && id.GetUid () <= owner->currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  Partition *current = GetCurrentPartition ();
+  return current == 0 ? 0 : current->index;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  Partition *current = GetCurrentPartition ();
+  return current == 0 ? m_global->currentContext : current->currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount (void) const
+{
+  Partition *current = GetCurrentPartition ();
+  if (current != 0 && current != m_global)
+    {
+      return current->eventCount;
+    }
+  uint64_t eventCount = m_global->eventCount;
+  for (auto partition : m_partitions)
+    {
+      eventCount += partition->eventCount;
+    }
+  return eventCount;
+}
+
+void
+MultithreadedSimulatorImpl::Barrier::Reset (uint32_t n)
+{
+  m_n = n;
+  m_waiting = 0;
+  m_generation = 0;
+}
+
+void
+MultithreadedSimulatorImpl::Barrier::Wait (void)
+{
+  if (m_n == 1)
+    {
+      return;
+    }
+  uint32_t generation = m_generation.load ();
+  if (m_waiting.fetch_add (1) + 1 == m_n)
+    {
+      m_waiting.store (0);
+      m_generation.fetch_add (1);
+    }
+  else
+    {
+      while (m_generation.load () == generation)
+        {
+          std::this_thread::yield ();
+        }
+    }
+}
+
+} // namespace ns3
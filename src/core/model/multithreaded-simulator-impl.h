@@ -0,0 +1,281 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "ptr.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * A conservative parallel simulator running partitions of the contexts
+ * (i.e., of the nodes) on several threads of a single process.
+ *
+ * The contexts are assigned to partitions with SetPartition() before the
+ * simulation starts (the contexts not assigned to any partition belong
+ * to partition 0). Each partition has its own event list, processed by
+ * its own thread. The events without context (Simulator::NO_CONTEXT),
+ * e.g., the events scheduled by the main program with Simulator::Schedule,
+ * are global events: they are executed by the main thread while the
+ * partitions are paused, before the events of the partitions with the
+ * same timestamp.
+ *
+ * The simulation advances by time windows: the partitions concurrently
+ * execute their events up to the end of the window, then synchronize at
+ * a barrier. A window ends at the earliest of the time of the next global
+ * event and the time of the next event of any partition plus the
+ * lookahead. Hence, the events scheduled with ScheduleWithContext() for a
+ * context of another partition must be delayed by at least the lookahead
+ * (this is checked); they are passed through a queue per pair of
+ * partitions, written without locking by the sending thread during the
+ * window and inserted in the event list of the receiving partition after
+ * the barrier. The lookahead is usually the minimum propagation delay
+ * between nodes of different partitions (see the Lookahead attribute).
+ *
+ * The events of a partition are executed in (timestamp, uid) order and
+ * the uids of the events received from other partitions are allocated in
+ * a fixed order, hence a simulation is deterministic for a given
+ * assignment of the contexts to partitions. It usually differs from a
+ * sequential simulation in the order of execution of simultaneous events.
+ *
+ * The models must not share mutable state between partitions: e.g., a
+ * channel must hand a copy of the transmitted packet to the receivers of
+ * other partitions (see Simulator::GetPartition()). Events cannot be
+ * removed or cancelled from another partition. Calling Simulator::Stop()
+ * from a partition stops it immediately and the other partitions at the
+ * end of the window.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   * Register this type.
+   * \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+  virtual uint32_t GetPartition (uint32_t context) const;
+  virtual Time GetLookahead (void) const;
+
+  /**
+   * Assign a context to a partition. The number of partitions, hence of
+   * threads, is one more than the largest partition assigned. This must
+   * be done before the simulation starts.
+   *
+   * \param [in] context The context (usually, a node id).
+   * \param [in] partition The partition.
+   */
+  void SetPartition (uint32_t context, uint32_t partition);
+  /**
+   * \returns The number of partitions.
+   */
+  uint32_t GetNPartitions (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** The state of a partition, i.e., of an event list processed by one thread. */
+  struct Partition
+  {
+    uint32_t index;                 //!< The index of the partition
+    Ptr<Scheduler> events;          //!< The event list
+    uint32_t uid;                   //!< Next event unique id
+    uint32_t currentUid;            //!< Unique id of the current event
+    uint64_t currentTs;             //!< Timestamp of the current event
+    uint32_t currentContext;        //!< Execution context of the current event
+    uint64_t eventCount;            //!< The number of events executed
+    bool stop;                      //!< Whether Stop() was called by an event of this partition
+    /**
+     * The events scheduled for the other partitions during the current
+     * window, indexed by the destination partition (the last one being
+     * the global events), whose uid is allocated by the destination.
+     */
+    std::vector<std::vector<Scheduler::Event> > outbox;
+  };
+
+  /** A barrier at which the threads of the partitions synchronize. */
+  class Barrier
+  {
+  public:
+    /**
+     * \param [in] n The number of threads synchronizing at the barrier.
+     */
+    void Reset (uint32_t n);
+    /** Wait until all the threads reach the barrier. */
+    void Wait (void);
+
+  private:
+    uint32_t m_n;                        //!< The number of threads
+    std::atomic<uint32_t> m_waiting;     //!< The number of threads waiting
+    std::atomic<uint32_t> m_generation;  //!< Incremented when all the threads reached the barrier
+  };
+
+  /**
+   * \returns The partition whose events are executed by the calling
+   * thread, or null if it is not running events.
+   */
+  Partition * GetCurrentPartition (void) const;
+  /**
+   * \param [in] context A context.
+   * \returns The partition executing the events of the context.
+   */
+  Partition * GetPartitionOf (uint32_t context) const;
+  /**
+   * Get the partition of an event, checking that the calling thread
+   * may access it.
+   *
+   * \param [in] id The event.
+   * \returns The partition of the event.
+   */
+  Partition * GetOwner (const EventId &id) const;
+  /**
+   * Insert an event in the event list of a partition, allocating its uid.
+   *
+   * \param [in] partition The partition.
+   * \param [in] ev The event.
+   */
+  void Insert (Partition *partition, Scheduler::Event &ev);
+  /** Move the events to the partitions of their context when the simulation starts. */
+  void Start (void);
+  /** Start the threads of the partitions other than partition 0. */
+  void StartThreads (void);
+  /**
+   * The main loop of a thread of a partition other than partition 0.
+   *
+   * \param [in] index The index of the partition.
+   */
+  void ThreadLoop (uint32_t index);
+  /**
+   * Run the windows of the simulation, on the thread of a partition.
+   *
+   * \param [in] index The index of the partition.
+   */
+  void RunPartition (uint32_t index);
+  /**
+   * Insert the events sent by the other partitions during the last
+   * window into the event list of a partition.
+   *
+   * \param [in] partition The partition.
+   */
+  void ReceiveEvents (Partition *partition);
+  /**
+   * Executed by the main thread between windows: execute the global
+   * events due before the next window and compute the end of that window.
+   */
+  void Coordinate (void);
+  /**
+   * Execute the events of a partition until the end of the window.
+   *
+   * \param [in] partition The partition.
+   */
+  void ProcessWindow (Partition *partition);
+  /**
+   * Execute an event.
+   *
+   * \param [in] partition The partition of the event.
+   * \param [in] next The event.
+   */
+  void Invoke (Partition *partition, const Scheduler::Event &next);
+
+  /** The partitions, created when the simulation starts. */
+  std::vector<Partition *> m_partitions;
+  /** The global events, i.e., the events without context and, before the simulation starts, all the events. */
+  Partition *m_global;
+  /** The partition of each context. */
+  std::vector<uint32_t> m_contextPartition;
+  /** The number of partitions. */
+  uint32_t m_nPartitions;
+  /** The lookahead. */
+  Time m_lookahead;
+  /** The factory of the schedulers. */
+  ObjectFactory m_schedulerFactory;
+  /** Whether the events were moved to the partitions of their context. */
+  bool m_started;
+  /** Whether the simulation must stop. */
+  std::atomic<bool> m_stop;
+  /** Whether the current run is over. */
+  bool m_done;
+  /** The end (exclusive) of the current window. */
+  uint64_t m_windowEnd;
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Protects the events to run at Destroy. */
+  mutable std::mutex m_destroyEventsMutex;
+
+  /** The threads of the partitions other than partition 0. */
+  std::vector<std::thread> m_threads;
+  /** Protects m_runs and m_exit. */
+  std::mutex m_threadsMutex;
+  /** Signals the threads to start a run or to exit. */
+  std::condition_variable m_threadsCondition;
+  /** The number of runs started. */
+  uint64_t m_runs;
+  /** Whether the threads must exit. */
+  bool m_exit;
+  /** The barrier of the threads. */
+  Barrier m_barrier;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -127,6 +127,7 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
 
           // No matching attribute value so we try to look at the env var.
           const char *envVar = getenv ("NS_ATTRIBUTE_DEFAULT");
+          bool fromEnv = false;
           if (envVar != 0 && std::strlen (envVar) > 0)
             {
               std::string env = envVar;
@@ -147,6 +148,7 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
                             {
                               NS_LOG_DEBUG ("construct \"" << tid.GetName () << "::" <<
                                             info.name << "\" from env var");
+                              fromEnv = true;
                               break;
                             }
                         }
@@ -154,6 +156,10 @@ ObjectBase::ConstructSelf (const AttributeConstructionList &attributes)
                   cur = next + 1;
                 }
             }
+          if (fromEnv)
+            {
+              continue;
+            }
 
           // No matching attribute value so we try to set the default value.
           DoSet (info.accessor, info.checker, *info.initialValue);
@@ -33,6 +33,7 @@
 #include "enum.h"
 
 
+#include <algorithm>
 #include <cmath>
 
 
@@ -108,6 +109,7 @@ void
 RealtimeSimulatorImpl::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
+  ProcessEventsWithContext ();
   while (!m_events->IsEmpty ())
     {
       Scheduler::Event next = m_events->RemoveNext ();
@@ -222,6 +224,15 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
         NS_ASSERT_MSG (m_synchronizer->Realtime (),
                        "RealtimeSimulatorImpl::ProcessOneEvent (): Synchronizer reports not Realtime ()");
 
+        //
+        // This resets the synchronizer so that any future event will cause it to
+        // interrupt the wait below (see there).  It is done before the events
+        // scheduled by other threads are moved into the event list, so that the
+        // Signal() following an event pushed after them is not lost.
+        //
+        m_synchronizer->SetCondition (false);
+        ProcessEventsWithContext ();
+
         //
         // tsNow is set to the normalized current real time.  When the simulation was
         // started, the current real time was effectively set to zero; so tsNow is
@@ -254,10 +265,9 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
         // We've figured out how long we need to delay in order to pace the
         // simulation time with the real time.  We're going to sleep, but need
         // to work with the synchronizer to make sure we're awakened if something
-        // external happens (like a packet is received).  This next line resets
-        // the synchronizer so that any future event will cause it to interrupt.
+        // external happens (like a packet is received): this is why the
+        // synchronizer was reset above.
         //
-        m_synchronizer->SetCondition (false);
       }
 
       //
@@ -325,8 +335,10 @@ RealtimeSimulatorImpl::ProcessOneEvent (void)
     // We do know we're waiting for an event, so there had better be an event on the
     // event queue.  Let's pull it off.  When we release the critical section, the
     // event we're working on won't be on the list and so subsequent operations won't
-    // mess with us.
+    // mess with us.  Events scheduled by other threads while we were waiting
+    // may be due before the one we waited for.
     //
+    ProcessEventsWithContext ();
     NS_ASSERT_MSG (m_events->IsEmpty () == false,
                    "RealtimeSimulatorImpl::ProcessOneEvent(): event queue is empty");
     next = m_events->RemoveNext ();
@@ -401,7 +413,7 @@ RealtimeSimulatorImpl::IsFinished (void) const
   bool rc;
   {
     CriticalSection cs (m_mutex);
-    rc = m_events->IsEmpty () || m_stop;
+    rc = (m_events->IsEmpty () && m_eventsWithContext.IsEmpty ()) || m_stop;
   }
 
   return rc;
@@ -419,6 +431,41 @@ RealtimeSimulatorImpl::NextTs (void) const
   return ev.key.m_ts;
 }
 
+void
+RealtimeSimulatorImpl::ProcessEventsWithContext (void)
+{
+  m_eventsWithContext.Drain ([this] (const EventWithContext & event)
+    {
+      //
+      // The timestamp of an event pushed while the simulator was running was
+      // computed from the real time clock without locking, hence it may be
+      // earlier than the last event executed since: schedule it now.
+      //
+      Scheduler::Event ev;
+      ev.impl = event.event;
+      ev.key.m_ts = event.relative ? m_currentTs + event.timestamp
+        : std::max (event.timestamp, m_currentTs);
+      ev.key.m_context = event.context;
+      ev.key.m_uid = m_uid;
+      m_uid++;
+      m_unscheduledEvents++;
+      m_events->Insert (ev);
+    });
+}
+
+void
+RealtimeSimulatorImpl::ScheduleFromOtherThread (uint32_t context, uint64_t ts, bool relative, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << ts << relative << event);
+  EventWithContext ev;
+  ev.context = context;
+  ev.timestamp = ts;
+  ev.relative = relative;
+  ev.event = event;
+  m_eventsWithContext.Push (ev);
+  m_synchronizer->Signal ();
+}
+
 void
 RealtimeSimulatorImpl::Run (void)
 {
@@ -444,6 +491,7 @@ RealtimeSimulatorImpl::Run (void)
       {
         CriticalSection cs (m_mutex);
 
+        ProcessEventsWithContext ();
         if (!m_events->IsEmpty ())
           {
             process = true;
@@ -544,23 +592,27 @@ RealtimeSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
 {
   NS_LOG_FUNCTION (this << context << delay << impl);
 
+  if (!SystemThread::Equals (m_main))
+    {
+      //
+      // If the simulator is running, we're pacing and have a meaningful
+      // realtime clock.  If we're not, then m_currentTs is where we stopped.
+      //
+      if (m_running)
+        {
+          ScheduleFromOtherThread (context, m_synchronizer->GetCurrentRealtime () + delay.GetTimeStep (),
+                                   false, impl);
+        }
+      else
+        {
+          ScheduleFromOtherThread (context, delay.GetTimeStep (), true, impl);
+        }
+      return;
+    }
+
   {
     CriticalSection cs (m_mutex);
-    uint64_t ts;
-
-    if (SystemThread::Equals (m_main))
-      {
-        ts = m_currentTs + delay.GetTimeStep ();
-      }
-    else
-      {
-        //
-        // If the simulator is running, we're pacing and have a meaningful
-        // realtime clock.  If we're not, then m_currentTs is where we stopped.
-        //
-        ts = m_running ? m_synchronizer->GetCurrentRealtime () : m_currentTs;
-        ts += delay.GetTimeStep ();
-      }
+    uint64_t ts = m_currentTs + delay.GetTimeStep ();
 
     NS_ASSERT_MSG (ts >= m_currentTs, "RealtimeSimulatorImpl::ScheduleRealtime(): schedule for time < m_currentTs");
     Scheduler::Event ev;
@@ -610,6 +662,13 @@ RealtimeSimulatorImpl::ScheduleRealtimeWithContext (uint32_t context, Time const
 {
   NS_LOG_FUNCTION (this << context << time << impl);
 
+  if (!SystemThread::Equals (m_main))
+    {
+      ScheduleFromOtherThread (context, m_synchronizer->GetCurrentRealtime () + time.GetTimeStep (),
+                               false, impl);
+      return;
+    }
+
   {
     CriticalSection cs (m_mutex);
 
@@ -618,6 +677,7 @@ RealtimeSimulatorImpl::ScheduleRealtimeWithContext (uint32_t context, Time const
     Scheduler::Event ev;
     ev.impl = impl;
     ev.key.m_ts = ts;
+    ev.key.m_context = context;
     ev.key.m_uid = m_uid;
     m_uid++;
     m_unscheduledEvents++;
@@ -637,6 +697,18 @@ void
 RealtimeSimulatorImpl::ScheduleRealtimeNowWithContext (uint32_t context, EventImpl *impl)
 {
   NS_LOG_FUNCTION (this << context << impl);
+  if (!SystemThread::Equals (m_main))
+    {
+      if (m_running)
+        {
+          ScheduleFromOtherThread (context, m_synchronizer->GetCurrentRealtime (), false, impl);
+        }
+      else
+        {
+          ScheduleFromOtherThread (context, 0, true, impl);
+        }
+      return;
+    }
   {
     CriticalSection cs (m_mutex);
 
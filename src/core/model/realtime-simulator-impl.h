@@ -30,6 +30,7 @@
 #include "assert.h"
 #include "log.h"
 #include "system-mutex.h"
+#include "mpsc-queue.h"
 
 #include <list>
 
@@ -174,6 +175,23 @@ private:
   uint64_t NextTs (void) const;
   /** Process the next event. */
   void ProcessOneEvent (void);
+  /**
+   * Move the events scheduled by other threads into the event list.
+   * Must be called by the main thread with the critical section locked.
+   */
+  void ProcessEventsWithContext (void);
+  /**
+   * Schedule an event from a thread other than the main thread, without
+   * locking the critical section.
+   *
+   * \param [in] context The event context.
+   * \param [in] ts The event timestamp, or its delay after the current
+   *             simulation time if \p relative.
+   * \param [in] relative Whether \p ts is relative to the current
+   *             simulation time when the event is moved into the event list.
+   * \param [in] event The event to schedule.
+   */
+  void ScheduleFromOtherThread (uint32_t context, uint64_t ts, bool relative, EventImpl *event);
   /** Destructor implementation. */
   virtual void DoDispose (void);
 
@@ -211,6 +229,25 @@ private:
   /** Mutex to control access to key state. */
   mutable SystemMutex m_mutex;
 
+  /** An event scheduled by a thread other than the main thread. */
+  struct EventWithContext
+  {
+    /** The event context. */
+    uint32_t context;
+    /** The event timestamp, or its delay if \c relative. */
+    uint64_t timestamp;
+    /** Whether the timestamp is relative to the current simulation time. */
+    bool relative;
+    /** The event implementation. */
+    EventImpl *event;
+  };
+  /**
+   * The events scheduled by other threads. They are pushed without
+   * locking #m_mutex, and moved in a batch into the event list by the
+   * main thread.
+   */
+  MpscQueue<EventWithContext> m_eventsWithContext;
+
   /** The synchronizer in use to track real time. */
   Ptr<Synchronizer> m_synchronizer;
 
@@ -42,4 +42,16 @@ SimulatorImpl::GetTypeId (void)
   return tid;
 }
 
+uint32_t
+SimulatorImpl::GetPartition (uint32_t context) const
+{
+  return 0;
+}
+
+Time
+SimulatorImpl::GetLookahead (void) const
+{
+  return Time (0);
+}
+
 } // namespace ns3
@@ -101,6 +101,18 @@ public:
   virtual uint32_t GetContext (void) const = 0;
   /** \copydoc Simulator::GetEventCount */
   virtual uint64_t GetEventCount (void) const = 0;
+  /**
+   * \copydoc Simulator::GetPartition
+   *
+   * The default implementation returns 0.
+   */
+  virtual uint32_t GetPartition (uint32_t context) const;
+  /**
+   * \copydoc Simulator::GetLookahead
+   *
+   * The default implementation returns zero.
+   */
+  virtual Time GetLookahead (void) const;
 
 };
 
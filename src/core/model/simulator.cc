@@ -152,6 +152,7 @@ Simulator::Destroy (void)
   (*pimpl)->Destroy ();
   (*pimpl)->Unref ();
   *pimpl = 0;
+  NS_LOG_INFO ("Event allocator: " << EventImpl::GetAllocatorStats ());
 }
 
 void
@@ -323,6 +324,32 @@ Simulator::GetSystemId (void)
     }
 }
 
+uint32_t
+Simulator::GetPartition (uint32_t context)
+{
+  if (*PeekImpl () != 0)
+    {
+      return GetImpl ()->GetPartition (context);
+    }
+  else
+    {
+      return 0;
+    }
+}
+
+Time
+Simulator::GetLookahead (void)
+{
+  if (*PeekImpl () != 0)
+    {
+      return GetImpl ()->GetLookahead ();
+    }
+  else
+    {
+      return Time (0);
+    }
+}
+
 void
 Simulator::SetImplementation (Ptr<SimulatorImpl> impl)
 {
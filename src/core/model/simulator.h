@@ -490,10 +490,37 @@ public:
    *
    * The system id is the identifier for this simulator instance
    * in a distributed simulation.  For MPI this is the MPI rank.
+   * In a multithreaded simulation, this is the partition of the
+   * calling thread, so that the identifiers allocated per system
+   * (e.g., packet uids) are unique.
    * @return The system id for this simulator.
    */
   static uint32_t GetSystemId (void);
 
+  /**
+   * Get the partition in which the events of a context are executed.
+   *
+   * The events of the contexts of a partition are executed in
+   * sequence by a single thread, concurrently with the events
+   * of the other partitions. Only the multithreaded simulator
+   * implementation has several partitions.
+   *
+   * @param [in] context The context.
+   * @return The partition of the context, 0 in a sequential simulation.
+   */
+  static uint32_t GetPartition (uint32_t context);
+
+  /**
+   * Get the lookahead of a multithreaded simulation.
+   *
+   * Events scheduled with ScheduleWithContext() for a context
+   * of another partition than the current one must be delayed
+   * by at least the lookahead.
+   *
+   * @return The lookahead, zero in a sequential simulation.
+   */
+  static Time GetLookahead (void);
+
 private:
   /** Default constructor. */
   Simulator ();
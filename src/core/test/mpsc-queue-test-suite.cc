@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/mpsc-queue.h"
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * MpscQueue test suite.
+ */
+
+namespace ns3 {
+
+namespace tests {
+
+
+/**
+ * \ingroup core-tests
+ * Check that the items pushed by a single thread are drained in order.
+ */
+class MpscQueueOrderTestCase : public TestCase
+{
+public:
+  MpscQueueOrderTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MpscQueueOrderTestCase::MpscQueueOrderTestCase ()
+  : TestCase ("Check the order of the items of a single producer")
+{
+}
+
+void
+MpscQueueOrderTestCase::DoRun (void)
+{
+  MpscQueue<int> queue;
+  NS_TEST_ASSERT_MSG_EQ (queue.IsEmpty (), true, "new queue not empty");
+  NS_TEST_ASSERT_MSG_EQ (queue.Drain ([] (int) {}), 0u, "items drained from an empty queue");
+
+  for (int i = 0; i < 10; i++)
+    {
+      queue.Push (i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (queue.IsEmpty (), false, "queue empty after Push");
+  std::vector<int> items;
+  std::size_t n = queue.Drain ([&items] (int item) { items.push_back (item); });
+  NS_TEST_ASSERT_MSG_EQ (n, 10u, "wrong number of items drained");
+  NS_TEST_ASSERT_MSG_EQ (queue.IsEmpty (), true, "queue not empty after Drain");
+  for (int i = 0; i < 10; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (items[i], i, "item " << i << " out of order");
+    }
+
+  // the items left are freed by the destructor
+  queue.Push (10);
+}
+
+
+/**
+ * \ingroup core-tests
+ * Check that no item is lost or reordered when several threads push
+ * while the consumer drains.
+ */
+class MpscQueueThreadsTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor.
+   * \param [in] producers The number of producer threads.
+   */
+  MpscQueueThreadsTestCase (uint32_t producers);
+
+private:
+  virtual void DoRun (void);
+
+  uint32_t m_producers; //!< The number of producer threads
+};
+
+MpscQueueThreadsTestCase::MpscQueueThreadsTestCase (uint32_t producers)
+  : TestCase ("Check concurrent pushes by " + std::to_string (producers) + " threads"),
+    m_producers (producers)
+{
+}
+
+void
+MpscQueueThreadsTestCase::DoRun (void)
+{
+  const uint32_t items = 20000;
+  // an item is the producer index and a sequence number
+  MpscQueue<std::pair<uint32_t, uint32_t> > queue;
+  std::atomic<uint32_t> done (0);
+  std::vector<std::thread> threads;
+  for (uint32_t p = 0; p < m_producers; p++)
+    {
+      threads.push_back (std::thread ([&queue, &done, p, items] ()
+        {
+          for (uint32_t i = 0; i < items; i++)
+            {
+              queue.Push (std::make_pair (p, i));
+            }
+          done++;
+        }));
+    }
+
+  std::vector<uint32_t> next (m_producers, 0);
+  bool ordered = true;
+  auto check = [&next, &ordered] (const std::pair<uint32_t, uint32_t> &item)
+    {
+      ordered = ordered && item.second == next[item.first];
+      next[item.first]++;
+    };
+  while (done < m_producers)
+    {
+      queue.Drain (check);
+    }
+  queue.Drain (check);
+  for (auto & thread : threads)
+    {
+      thread.join ();
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (ordered, true, "items of a producer out of order");
+  for (uint32_t p = 0; p < m_producers; p++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (next[p], items, "items of producer " << p << " lost");
+    }
+  NS_TEST_ASSERT_MSG_EQ (queue.IsEmpty (), true, "queue not empty");
+}
+
+
+/**
+ * \ingroup core-tests
+ * MpscQueue test suite.
+ */
+class MpscQueueTestSuite : public TestSuite
+{
+public:
+  MpscQueueTestSuite ()
+    : TestSuite ("mpsc-queue")
+  {
+    AddTestCase (new MpscQueueOrderTestCase);
+    AddTestCase (new MpscQueueThreadsTestCase (1));
+    AddTestCase (new MpscQueueThreadsTestCase (4));
+  }
+};
+
+static MpscQueueTestSuite g_mpscQueueTestSuite; //!< Static variable for test initialization
+
+
+}    // namespace tests
+
+}  // namespace ns3
@@ -0,0 +1,296 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/nstime.h"
+
+#include <algorithm>
+#include <atomic>
+#include <tuple>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup core-tests
+ *
+ * Exchange events between contexts of several partitions and check that
+ * the simulation is deterministic and executes the same events as a
+ * sequential simulation.
+ */
+class MultithreadedSimulatorExchangeTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorExchangeTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /** An executed event: timestamp, value and system id. */
+  typedef std::tuple<int64_t, uint32_t, uint32_t> Record;
+  /** The executed events of each context. */
+  typedef std::vector<std::vector<Record> > Records;
+
+  /**
+   * Run the simulation.
+   *
+   * \param [in] nPartitions The number of partitions, 0 for a sequential simulation.
+   * \returns The events executed for each context.
+   */
+  Records RunSimulation (uint32_t nPartitions);
+  /**
+   * An event of a context.
+   *
+   * \param [in] context The context.
+   * \param [in] value The value of the event.
+   */
+  void Receive (uint32_t context, uint32_t value);
+  /**
+   * A local event of a context, which does not schedule any event.
+   *
+   * \param [in] context The context.
+   * \param [in] value The value of the event.
+   */
+  void Local (uint32_t context, uint32_t value);
+  /**
+   * A global event, scheduling an event for a context.
+   *
+   * \param [in] context The context.
+   */
+  void Global (uint32_t context);
+
+  static const uint32_t N_CONTEXTS = 8; //!< The number of contexts
+  static const uint32_t N_HOPS = 200;   //!< The number of events sent by each context
+  Time m_lookahead;                     //!< The lookahead
+  Records m_records;                    //!< The events executed for each context
+};
+
+MultithreadedSimulatorExchangeTestCase::MultithreadedSimulatorExchangeTestCase ()
+  : TestCase ("Check that a multithreaded simulation is deterministic and matches a sequential one"),
+    m_lookahead (MicroSeconds (3))
+{
+}
+
+void
+MultithreadedSimulatorExchangeTestCase::Receive (uint32_t context, uint32_t value)
+{
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetContext (), context, "Wrong context");
+  m_records[context].push_back (std::make_tuple (Simulator::Now ().GetNanoSeconds (), value,
+                                                 Simulator::GetSystemId ()));
+  if (value % N_HOPS == N_HOPS - 1)
+    {
+      return;
+    }
+  // a local event, and an event for a context of another partition
+  // (unless there is a single partition) with various delays
+  if (value % 5 == 0)
+    {
+      Simulator::Schedule (NanoSeconds (value % 7), &MultithreadedSimulatorExchangeTestCase::Local,
+                           this, context, value + 1);
+    }
+  uint32_t next = (context + 1 + value % 3) % N_CONTEXTS;
+  Simulator::ScheduleWithContext (next, m_lookahead + NanoSeconds ((value * 37) % 1000),
+                                  &MultithreadedSimulatorExchangeTestCase::Receive,
+                                  this, next, value + 1);
+}
+
+void
+MultithreadedSimulatorExchangeTestCase::Local (uint32_t context, uint32_t value)
+{
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetContext (), context, "Wrong context");
+  m_records[context].push_back (std::make_tuple (Simulator::Now ().GetNanoSeconds (), value,
+                                                 Simulator::GetSystemId ()));
+}
+
+void
+MultithreadedSimulatorExchangeTestCase::Global (uint32_t context)
+{
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetContext (), Simulator::NO_CONTEXT, "Wrong context");
+  Simulator::ScheduleWithContext (context, Time (0), &MultithreadedSimulatorExchangeTestCase::Receive,
+                                  this, context, 100000 * (context + 1));
+}
+
+MultithreadedSimulatorExchangeTestCase::Records
+MultithreadedSimulatorExchangeTestCase::RunSimulation (uint32_t nPartitions)
+{
+  if (nPartitions > 0)
+    {
+      Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl> ();
+      impl->SetAttribute ("Lookahead", TimeValue (m_lookahead));
+      for (uint32_t context = 0; context < N_CONTEXTS; context++)
+        {
+          impl->SetPartition (context, context % nPartitions);
+        }
+      NS_TEST_EXPECT_MSG_EQ (impl->GetNPartitions (), nPartitions, "Wrong number of partitions");
+      Simulator::SetImplementation (impl);
+    }
+  else
+    {
+      Simulator::SetImplementation (CreateObject<DefaultSimulatorImpl> ());
+    }
+
+  m_records.assign (N_CONTEXTS, std::vector<Record> ());
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      Simulator::ScheduleWithContext (context, NanoSeconds (context), &MultithreadedSimulatorExchangeTestCase::Receive,
+                                      this, context, N_HOPS * context);
+      Simulator::Schedule (MicroSeconds (50 * (context + 1)), &MultithreadedSimulatorExchangeTestCase::Global,
+                           this, context);
+    }
+  // stop and resume
+  Simulator::Stop (MicroSeconds (200));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MicroSeconds (200), "Wrong time after stopping");
+  uint64_t eventCount = Simulator::GetEventCount ();
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_GT (Simulator::GetEventCount (), eventCount, "The simulation was not resumed");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::IsFinished (), true, "The simulation should be finished");
+  Simulator::Destroy ();
+  return m_records;
+}
+
+void
+MultithreadedSimulatorExchangeTestCase::DoRun (void)
+{
+  Records sequential = RunSimulation (0);
+  Records parallel = RunSimulation (4);
+  NS_TEST_EXPECT_MSG_EQ ((parallel == RunSimulation (4)), true, "The simulation is not deterministic");
+
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      NS_TEST_EXPECT_MSG_GT (parallel[context].size (), N_HOPS, "Too few events executed");
+      for (auto & record : parallel[context])
+        {
+          NS_TEST_EXPECT_MSG_EQ (std::get<2> (record), context % 4, "Event executed by the wrong partition");
+          std::get<2> (record) = 0;
+        }
+      // simultaneous events may be executed in a different order
+      std::sort (sequential[context].begin (), sequential[context].end ());
+      std::sort (parallel[context].begin (), parallel[context].end ());
+      NS_TEST_EXPECT_MSG_EQ ((parallel[context] == sequential[context]), true,
+                             "Different events executed for context " << context);
+    }
+
+  // a single partition runs on the main thread
+  Records single = RunSimulation (1);
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      std::sort (single[context].begin (), single[context].end ());
+      NS_TEST_EXPECT_MSG_EQ ((single[context] == sequential[context]), true,
+                             "Different events executed for context " << context);
+    }
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * Check the removal and cancellation of events in a partition.
+ */
+class MultithreadedSimulatorRemoveTestCase : public TestCase
+{
+public:
+  MultithreadedSimulatorRemoveTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /** Schedule events and remove or cancel them. */
+  void Start (void);
+  /** An event that must not be executed. */
+  void Removed (void);
+  /** An event that must be executed. */
+  void Kept (void);
+
+  std::atomic<uint32_t> m_removed; //!< The number of executions of Removed
+  std::atomic<uint32_t> m_kept;    //!< The number of executions of Kept
+};
+
+MultithreadedSimulatorRemoveTestCase::MultithreadedSimulatorRemoveTestCase ()
+  : TestCase ("Check the removal of events in a multithreaded simulation"),
+    m_removed (0),
+    m_kept (0)
+{
+}
+
+void
+MultithreadedSimulatorRemoveTestCase::Removed (void)
+{
+  m_removed++;
+}
+
+void
+MultithreadedSimulatorRemoveTestCase::Kept (void)
+{
+  m_kept++;
+}
+
+void
+MultithreadedSimulatorRemoveTestCase::Start (void)
+{
+  EventId a = Simulator::Schedule (MicroSeconds (1), &MultithreadedSimulatorRemoveTestCase::Removed, this);
+  EventId b = Simulator::Schedule (MicroSeconds (1), &MultithreadedSimulatorRemoveTestCase::Removed, this);
+  EventId c = Simulator::Schedule (MicroSeconds (2), &MultithreadedSimulatorRemoveTestCase::Kept, this);
+  NS_TEST_EXPECT_MSG_EQ (a.IsRunning (), true, "The event should be pending");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::GetDelayLeft (c), MicroSeconds (2), "Wrong delay left");
+  Simulator::Remove (a);
+  b.Cancel ();
+  NS_TEST_EXPECT_MSG_EQ (a.IsExpired (), true, "The event should be expired");
+  NS_TEST_EXPECT_MSG_EQ (b.IsExpired (), true, "The event should be expired");
+}
+
+void
+MultithreadedSimulatorRemoveTestCase::DoRun (void)
+{
+  Ptr<MultithreadedSimulatorImpl> impl = CreateObject<MultithreadedSimulatorImpl> ();
+  impl->SetAttribute ("Lookahead", TimeValue (MicroSeconds (1)));
+  impl->SetPartition (0, 0);
+  impl->SetPartition (1, 1);
+  Simulator::SetImplementation (impl);
+
+  for (uint32_t context = 0; context < 2; context++)
+    {
+      Simulator::ScheduleWithContext (context, MicroSeconds (10), &MultithreadedSimulatorRemoveTestCase::Start, this);
+    }
+  // events removed by the main program
+  EventId a = Simulator::Schedule (MicroSeconds (5), &MultithreadedSimulatorRemoveTestCase::Removed, this);
+  Simulator::Stop (MicroSeconds (1));
+  Simulator::Run ();
+  Simulator::Remove (a);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_removed.load (), 0, "Removed events executed");
+  NS_TEST_EXPECT_MSG_EQ (m_kept.load (), 2, "Wrong number of events executed");
+}
+
+/**
+ * \ingroup core-tests
+ *
+ * The multithreaded simulator test suite.
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+public:
+  MultithreadedSimulatorTestSuite ()
+    : TestSuite ("multithreaded-simulator")
+  {
+    AddTestCase (new MultithreadedSimulatorExchangeTestCase (), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorRemoveTestCase (), TestCase::QUICK);
+  }
+};
+
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite; //!< Static variable for test initialization
@@ -19,11 +19,18 @@
  */
 #include "ns3/test.h"
 #include "ns3/simulator.h"
+#include "ns3/event-impl.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/dary-heap-scheduler.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/boolean.h"
+#include <sstream>
+#include <vector>
 
 using namespace ns3;
 
@@ -170,6 +177,248 @@ SimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_destroy, true, "Event should have run");
 }
 
+class SimulatorRandomEventsTestCase : public TestCase
+{
+public:
+  SimulatorRandomEventsTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  void Event (uint32_t index);
+  void ScheduleEvents (uint32_t n);
+  Ptr<UniformRandomVariable> m_random;
+  std::vector<EventId> m_ids;
+  std::vector<bool> m_removed;
+  std::vector<uint32_t> m_runs;
+  uint64_t m_lastTs;
+  uint32_t m_lastUid;
+  bool m_ordered;
+  ObjectFactory m_schedulerFactory;
+};
+
+SimulatorRandomEventsTestCase::SimulatorRandomEventsTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that events scheduled, removed and cancelled at random run in order with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{}
+
+void
+SimulatorRandomEventsTestCase::ScheduleEvents (uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+    {
+      uint32_t index = m_ids.size ();
+      // few distinct delays, so that many events have the same timestamp
+      Time delay = MicroSeconds (m_random->GetInteger (0, 50));
+      m_ids.push_back (Simulator::Schedule (delay, &SimulatorRandomEventsTestCase::Event, this, index));
+      m_removed.push_back (false);
+      m_runs.push_back (0);
+    }
+  // remove or cancel some of the pending events
+  for (uint32_t i = 0; i < n / 2; i++)
+    {
+      uint32_t index = m_random->GetInteger (0, m_ids.size () - 1);
+      if (!m_ids[index].IsExpired ())
+        {
+          if (m_random->GetInteger (0, 1) == 0)
+            {
+              Simulator::Remove (m_ids[index]);
+            }
+          else
+            {
+              Simulator::Cancel (m_ids[index]);
+            }
+          m_removed[index] = true;
+        }
+    }
+}
+
+void
+SimulatorRandomEventsTestCase::Event (uint32_t index)
+{
+  uint64_t ts = Simulator::Now ().GetTimeStep ();
+  uint32_t uid = m_ids[index].GetUid ();
+  if (ts < m_lastTs || (ts == m_lastTs && uid <= m_lastUid))
+    {
+      m_ordered = false;
+    }
+  m_lastTs = ts;
+  m_lastUid = uid;
+  m_runs[index]++;
+  if (m_ids.size () < 20000)
+    {
+      ScheduleEvents (m_random->GetInteger (0, 3));
+    }
+}
+
+void
+SimulatorRandomEventsTestCase::DoRun (void)
+{
+  m_lastTs = 0;
+  m_lastUid = 0;
+  m_ordered = true;
+  Simulator::SetScheduler (m_schedulerFactory);
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (1);
+
+  ScheduleEvents (1000);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_ordered, true, "Events did not run in order");
+  for (std::size_t i = 0; i < m_ids.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_runs[i], (m_removed[i] ? 0 : 1), "Unexpected number of runs of event " << i);
+    }
+  Simulator::Destroy ();
+  m_ids.clear ();
+}
+
+class SimulatorEventAllocatorTestCase : public TestCase
+{
+public:
+  SimulatorEventAllocatorTestCase ();
+  virtual void DoRun (void);
+  /** Bound arguments too large for the pool of the events. */
+  struct Large
+  {
+    uint8_t data[512]; //!< The payload
+  };
+  void SmallEvent (uint32_t value);
+  void LargeEvent (Large value);
+  uint32_t m_runs;
+};
+
+SimulatorEventAllocatorTestCase::SimulatorEventAllocatorTestCase ()
+  : TestCase ("Check that events are recycled by the allocator of the events")
+{}
+
+void
+SimulatorEventAllocatorTestCase::SmallEvent (uint32_t value)
+{
+  m_runs++;
+}
+
+void
+SimulatorEventAllocatorTestCase::LargeEvent (Large value)
+{
+  m_runs++;
+}
+
+void
+SimulatorEventAllocatorTestCase::DoRun (void)
+{
+  m_runs = 0;
+  EventImpl::AllocatorStats before = EventImpl::GetAllocatorStats ();
+
+  // a freed event is reused by the next event of the same size
+  EventId id = Simulator::Schedule (Seconds (1), &SimulatorEventAllocatorTestCase::SmallEvent, this, 0);
+  EventImpl *first = id.PeekEventImpl ();
+  Simulator::Remove (id);
+  id = EventId ();
+  id = Simulator::Schedule (Seconds (1), &SimulatorEventAllocatorTestCase::SmallEvent, this, 1);
+  NS_TEST_EXPECT_MSG_EQ (id.PeekEventImpl (), first, "The memory of the removed event was not reused");
+
+  std::vector<EventId> ids;
+  Large large = Large ();
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      ids.push_back (Simulator::Schedule (MicroSeconds (i), &SimulatorEventAllocatorTestCase::SmallEvent, this, i));
+      if (i % 10 == 0)
+        {
+          ids.push_back (Simulator::Schedule (MicroSeconds (i), &SimulatorEventAllocatorTestCase::LargeEvent, this, large));
+        }
+      if (i % 2 == 0)
+        {
+          Simulator::Cancel (ids.back ());
+        }
+    }
+  EventImpl::AllocatorStats during = EventImpl::GetAllocatorStats ();
+  NS_TEST_EXPECT_MSG_EQ (during.allocations - during.deallocations - (before.allocations - before.deallocations),
+                         1101, "Unexpected number of live events");
+  NS_TEST_EXPECT_MSG_EQ (during.large - before.large, 100, "Unexpected number of large events");
+
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_runs, 601, "Unexpected number of events run");
+  Simulator::Destroy ();
+  ids.clear ();
+  id = EventId ();
+
+  EventImpl::AllocatorStats after = EventImpl::GetAllocatorStats ();
+  NS_TEST_EXPECT_MSG_EQ (after.allocations - before.allocations, after.deallocations - before.deallocations,
+                         "Some events were not freed");
+}
+
+class SimulatorProfileTestCase : public TestCase
+{
+public:
+  SimulatorProfileTestCase ();
+  virtual void DoRun (void);
+  void EventA (uint32_t value);
+  void EventB (void);
+  /**
+   * \param profile A profile.
+   * \param name The name of a row of the profile.
+   * \returns The number of events of the row, 0 if it is not found.
+   */
+  static uint64_t GetCount (std::string profile, std::string name);
+};
+
+SimulatorProfileTestCase::SimulatorProfileTestCase ()
+  : TestCase ("Check the profile of the events executed")
+{}
+
+void
+SimulatorProfileTestCase::EventA (uint32_t value)
+{}
+
+void
+SimulatorProfileTestCase::EventB (void)
+{}
+
+uint64_t
+SimulatorProfileTestCase::GetCount (std::string profile, std::string name)
+{
+  std::istringstream is (profile);
+  std::string line;
+  while (std::getline (is, line))
+    {
+      std::size_t pos = line.rfind ("  " + name);
+      if (pos != std::string::npos && pos + 2 + name.size () == line.size ())
+        {
+          return std::stoull (line);
+        }
+    }
+  return 0;
+}
+
+void
+SimulatorProfileTestCase::DoRun (void)
+{
+  Ptr<DefaultSimulatorImpl> impl = CreateObject<DefaultSimulatorImpl> ();
+  impl->SetAttribute ("Profile", BooleanValue (true));
+  Simulator::SetImplementation (impl);
+
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Simulator::ScheduleWithContext (7, Seconds (i), &SimulatorProfileTestCase::EventA, this, i);
+    }
+  Simulator::Schedule (Seconds (5), &SimulatorProfileTestCase::EventB, this);
+  Simulator::Run ();
+
+  std::ostringstream os;
+  impl->PrintProfile (os);
+  std::string profile = os.str ();
+  NS_TEST_EXPECT_MSG_NE (profile.find ("4 events executed"), std::string::npos, "Wrong number of events");
+  NS_TEST_EXPECT_MSG_EQ (GetCount (profile, "void (SimulatorProfileTestCase::*)(unsigned int)"), 3,
+                         "Wrong number of events of type A");
+  NS_TEST_EXPECT_MSG_EQ (GetCount (profile, "void (SimulatorProfileTestCase::*)()"), 1,
+                         "Wrong number of events of type B");
+  NS_TEST_EXPECT_MSG_EQ (GetCount (profile, "7"), 3, "Wrong number of events of context 7");
+  NS_TEST_EXPECT_MSG_EQ (GetCount (profile, "none"), 1, "Wrong number of events without context");
+
+  // profiling can be disabled at any time
+  impl->SetAttribute ("Profile", BooleanValue (false));
+  Simulator::Destroy ();
+}
+
 class SimulatorTemplateTestCase : public TestCase
 {
 public:
@@ -483,5 +732,17 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (PriorityQueueScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (DaryHeapScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+
+    for (TypeId tid : {ListScheduler::GetTypeId (), MapScheduler::GetTypeId (), HeapScheduler::GetTypeId (),
+                       CalendarScheduler::GetTypeId (), PriorityQueueScheduler::GetTypeId (),
+                       DaryHeapScheduler::GetTypeId ()})
+      {
+        factory.SetTypeId (tid);
+        AddTestCase (new SimulatorRandomEventsTestCase (factory), TestCase::QUICK);
+      }
+    AddTestCase (new SimulatorEventAllocatorTestCase (), TestCase::QUICK);
+    AddTestCase (new SimulatorProfileTestCase (), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include "ns3/log.h"
+#include "ns3/callback.h"
+#include "grid-spatial-index.h"
+#include "mobility-model.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("GridSpatialIndex");
+
+GridSpatialIndex::GridSpatialIndex (double cellSize)
+  : m_cellSize (cellSize)
+{
+  NS_LOG_FUNCTION (this << cellSize);
+  NS_ASSERT (cellSize > 0);
+}
+
+GridSpatialIndex::~GridSpatialIndex ()
+{
+  NS_LOG_FUNCTION (this);
+  Clear ();
+}
+
+uint32_t
+GridSpatialIndex::Add (Ptr<MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  uint32_t id = m_items.size ();
+  m_items.push_back ({mobility, false, 0});
+  if (mobility)
+    {
+      auto it = m_ids.find (PeekPointer (mobility));
+      if (it == m_ids.end ())
+        {
+          it = m_ids.insert ({PeekPointer (mobility), {}}).first;
+          mobility->TraceConnectWithoutContext ("CourseChange", MakeCallback (&GridSpatialIndex::NotifyCourseChange, this));
+        }
+      it->second.push_back (id);
+    }
+  Insert (id);
+  return id;
+}
+
+void
+GridSpatialIndex::Clear (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (const auto & mobilityIds : m_ids)
+    {
+      m_items[mobilityIds.second.front ()].mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                                                                     MakeCallback (&GridSpatialIndex::NotifyCourseChange, this));
+    }
+  m_ids.clear ();
+  m_items.clear ();
+  m_cells.clear ();
+  m_alwaysCandidates.clear ();
+}
+
+uint32_t
+GridSpatialIndex::GetN (void) const
+{
+  return m_items.size ();
+}
+
+double
+GridSpatialIndex::GetCellSize (void) const
+{
+  return m_cellSize;
+}
+
+GridSpatialIndex::CellKey
+GridSpatialIndex::GetCellKey (int64_t x, int64_t y)
+{
+  return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) | static_cast<uint32_t> (y);
+}
+
+int64_t
+GridSpatialIndex::GetCellCoordinate (double coordinate) const
+{
+  return static_cast<int64_t> (std::floor (coordinate / m_cellSize));
+}
+
+void
+GridSpatialIndex::Insert (uint32_t id)
+{
+  Item &item = m_items[id];
+  if (item.mobility)
+    {
+      Vector velocity = item.mobility->GetVelocity ();
+      if (velocity.x == 0 && velocity.y == 0 && velocity.z == 0)
+        {
+          Vector position = item.mobility->GetPosition ();
+          item.inCell = true;
+          item.cell = GetCellKey (GetCellCoordinate (position.x), GetCellCoordinate (position.y));
+          m_cells[item.cell].push_back (id);
+          return;
+        }
+    }
+  item.inCell = false;
+  m_alwaysCandidates.push_back (id);
+}
+
+void
+GridSpatialIndex::Erase (uint32_t id)
+{
+  Item &item = m_items[id];
+  std::vector<uint32_t> *ids = &m_alwaysCandidates;
+  if (item.inCell)
+    {
+      auto cellIt = m_cells.find (item.cell);
+      NS_ASSERT (cellIt != m_cells.end ());
+      ids = &cellIt->second;
+    }
+  auto it = std::find (ids->begin (), ids->end (), id);
+  NS_ASSERT (it != ids->end ());
+  ids->erase (it);
+  if (item.inCell && ids->empty ())
+    {
+      m_cells.erase (item.cell);
+    }
+}
+
+void
+GridSpatialIndex::NotifyCourseChange (Ptr<const MobilityModel> mobility)
+{
+  NS_LOG_FUNCTION (this << mobility);
+  auto it = m_ids.find (PeekPointer (mobility));
+  NS_ASSERT (it != m_ids.end ());
+  for (uint32_t id : it->second)
+    {
+      Erase (id);
+      Insert (id);
+    }
+}
+
+void
+GridSpatialIndex::GetCandidates (const Vector &position, double distance, std::vector<uint32_t> &candidates) const
+{
+  NS_LOG_FUNCTION (this << position << distance);
+  candidates = m_alwaysCandidates;
+  int64_t xMin = GetCellCoordinate (position.x - distance);
+  int64_t xMax = GetCellCoordinate (position.x + distance);
+  int64_t yMin = GetCellCoordinate (position.y - distance);
+  int64_t yMax = GetCellCoordinate (position.y + distance);
+  if (static_cast<double> (xMax - xMin + 1) * (yMax - yMin + 1) > m_cells.size ())
+    {
+      // fewer non-empty cells than cells to look at
+      for (const auto & cell : m_cells)
+        {
+          int64_t x = static_cast<int32_t> (cell.first >> 32);
+          int64_t y = static_cast<int32_t> (cell.first & 0xffffffff);
+          if (x >= xMin && x <= xMax && y >= yMin && y <= yMax)
+            {
+              candidates.insert (candidates.end (), cell.second.begin (), cell.second.end ());
+            }
+        }
+    }
+  else
+    {
+      for (int64_t x = xMin; x <= xMax; x++)
+        {
+          for (int64_t y = yMin; y <= yMax; y++)
+            {
+              auto it = m_cells.find (GetCellKey (x, y));
+              if (it != m_cells.end ())
+                {
+                  candidates.insert (candidates.end (), it->second.begin (), it->second.end ());
+                }
+            }
+        }
+    }
+  std::sort (candidates.begin (), candidates.end ());
+}
+
+} // namespace ns3
@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef GRID_SPATIAL_INDEX_H
+#define GRID_SPATIAL_INDEX_H
+
+#include <vector>
+#include <unordered_map>
+#include "ns3/simple-ref-count.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+
+namespace ns3 {
+
+class MobilityModel;
+
+/**
+ * \ingroup mobility
+ *
+ * \brief Grid index of the positions of a set of mobility models.
+ *
+ * Items (identified by their insertion order) are stored in the square
+ * cell of the XY plane containing their position, so that the items that
+ * may be within a given distance of a position can be found without
+ * looking at all of them. Positions are updated when the CourseChange
+ * trace of the mobility models fires. Since items moving at a non-zero
+ * velocity change their position without notifying it, such items are
+ * not stored in a cell and are always returned as candidates, as well as
+ * items without mobility model.
+ */
+class GridSpatialIndex : public SimpleRefCount<GridSpatialIndex>
+{
+public:
+  /**
+   * Create an empty index
+   *
+   * \param cellSize the length (m) of the side of the cells
+   */
+  GridSpatialIndex (double cellSize);
+  ~GridSpatialIndex ();
+
+  /**
+   * Add an item to the index.
+   *
+   * \param mobility the mobility model of the item (may be null)
+   * \return the identifier of the item, i.e., the number of items
+   *         previously added
+   */
+  uint32_t Add (Ptr<MobilityModel> mobility);
+  /**
+   * Remove all the items from the index.
+   */
+  void Clear (void);
+  /**
+   * \return the number of items in the index
+   */
+  uint32_t GetN (void) const;
+  /**
+   * \return the length (m) of the side of the cells
+   */
+  double GetCellSize (void) const;
+  /**
+   * Get the items that may be within the given distance of the given
+   * position. All the items within that distance are returned, along
+   * with some items that are farther away.
+   *
+   * \param position the position
+   * \param distance the distance (m)
+   * \param candidates the vector filled with the identifiers of the
+   *        candidate items, sorted in increasing order
+   */
+  void GetCandidates (const Vector &position, double distance, std::vector<uint32_t> &candidates) const;
+
+private:
+  /// Key of a cell
+  typedef uint64_t CellKey;
+
+  /// Information about an item
+  struct Item
+  {
+    Ptr<MobilityModel> mobility; //!< the mobility model
+    bool inCell;                 //!< whether the item is stored in a cell
+    CellKey cell;                //!< the cell storing the item, if any
+  };
+
+  /**
+   * \param x the X coordinate of the cell
+   * \param y the Y coordinate of the cell
+   * \return the key of the cell
+   */
+  static CellKey GetCellKey (int64_t x, int64_t y);
+  /**
+   * \param coordinate the X or Y coordinate of a position
+   * \return the corresponding coordinate of the cell containing that position
+   */
+  int64_t GetCellCoordinate (double coordinate) const;
+  /**
+   * Store an item in the cell containing its current position, or in the
+   * list of items always returned as candidates if it is moving.
+   *
+   * \param id the identifier of the item
+   */
+  void Insert (uint32_t id);
+  /**
+   * Remove an item from the cell or the list it is stored in.
+   *
+   * \param id the identifier of the item
+   */
+  void Erase (uint32_t id);
+  /**
+   * Update the items of a mobility model whose course changed.
+   *
+   * \param mobility the mobility model
+   */
+  void NotifyCourseChange (Ptr<const MobilityModel> mobility);
+
+  double m_cellSize;                                                       //!< length of the side of the cells
+  std::vector<Item> m_items;                                               //!< items indexed by their identifier
+  std::unordered_map<const MobilityModel *, std::vector<uint32_t> > m_ids; //!< identifiers of the items of each mobility model
+  std::unordered_map<CellKey, std::vector<uint32_t> > m_cells;             //!< items stored in each cell
+  std::vector<uint32_t> m_alwaysCandidates;                                //!< items that are not stored in a cell
+};
+
+} // namespace ns3
+
+#endif /* GRID_SPATIAL_INDEX_H */
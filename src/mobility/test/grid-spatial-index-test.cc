@@ -0,0 +1,166 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/grid-spatial-index.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Check that GridSpatialIndex returns, in increasing order, all
+ * the items within a given distance, including after course changes
+ * and for moving items.
+ */
+class GridSpatialIndexTest : public TestCase
+{
+public:
+  GridSpatialIndexTest ();
+  virtual ~GridSpatialIndexTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Check the candidates returned by the index for random positions
+   */
+  void CheckCandidates (void);
+  /**
+   * Move some of the static items
+   */
+  void MoveItems (void);
+
+  Ptr<GridSpatialIndex> m_index;                  ///< the index
+  std::vector<Ptr<MobilityModel> > m_mobilities; ///< the mobility models of the items
+  Ptr<UniformRandomVariable> m_random;           ///< random variable
+};
+
+GridSpatialIndexTest::GridSpatialIndexTest ()
+  : TestCase ("Check the candidates returned by the grid spatial index")
+{
+}
+
+GridSpatialIndexTest::~GridSpatialIndexTest ()
+{
+}
+
+void
+GridSpatialIndexTest::CheckCandidates (void)
+{
+  std::vector<uint32_t> candidates;
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      Vector position (m_random->GetValue (-100, 100), m_random->GetValue (-100, 100), m_random->GetValue (0, 10));
+      double distance = m_random->GetValue (0, 60);
+      m_index->GetCandidates (position, distance, candidates);
+      NS_TEST_EXPECT_MSG_EQ (std::is_sorted (candidates.begin (), candidates.end ()), true, "Candidates are not sorted");
+      NS_TEST_EXPECT_MSG_EQ ((std::adjacent_find (candidates.begin (), candidates.end ()) == candidates.end ()), true,
+                             "Candidates are not unique");
+      for (uint32_t id = 0; id < m_mobilities.size (); id++)
+        {
+          if (CalculateDistance (m_mobilities[id]->GetPosition (), position) <= distance)
+            {
+              NS_TEST_EXPECT_MSG_EQ (std::binary_search (candidates.begin (), candidates.end (), id), true,
+                                     "Item " << id << " within " << distance << " m of " << position << " is not a candidate");
+            }
+        }
+    }
+}
+
+void
+GridSpatialIndexTest::MoveItems (void)
+{
+  for (uint32_t id = 0; id < m_mobilities.size (); id += 3)
+    {
+      Ptr<ConstantVelocityMobilityModel> mobility = DynamicCast<ConstantVelocityMobilityModel> (m_mobilities[id]);
+      if (mobility)
+        {
+          // stop the moving item
+          mobility->SetVelocity (Vector (0, 0, 0));
+        }
+      else
+        {
+          m_mobilities[id]->SetPosition (Vector (m_random->GetValue (-100, 100), m_random->GetValue (-100, 100), 0));
+        }
+    }
+}
+
+void
+GridSpatialIndexTest::DoRun (void)
+{
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (1);
+  m_index = Create<GridSpatialIndex> (20);
+  for (uint32_t id = 0; id < 200; id++)
+    {
+      Ptr<MobilityModel> mobility;
+      if (id % 10 == 0)
+        {
+          mobility = CreateObject<ConstantVelocityMobilityModel> ();
+        }
+      else
+        {
+          mobility = CreateObject<ConstantPositionMobilityModel> ();
+        }
+      mobility->SetPosition (Vector (m_random->GetValue (-100, 100), m_random->GetValue (-100, 100), 0));
+      if (id % 10 == 0)
+        {
+          // the velocity must be set after the position, which resets it
+          DynamicCast<ConstantVelocityMobilityModel> (mobility)->SetVelocity (Vector (m_random->GetValue (-10, 10), m_random->GetValue (-10, 10), 0));
+        }
+      m_mobilities.push_back (mobility);
+      NS_TEST_EXPECT_MSG_EQ (m_index->Add (mobility), id, "Unexpected item identifier");
+    }
+  NS_TEST_EXPECT_MSG_EQ (m_index->GetN (), 200, "Unexpected number of items");
+
+  Simulator::Schedule (Seconds (0), &GridSpatialIndexTest::CheckCandidates, this);
+  Simulator::Schedule (Seconds (5), &GridSpatialIndexTest::CheckCandidates, this);
+  Simulator::Schedule (Seconds (6), &GridSpatialIndexTest::MoveItems, this);
+  Simulator::Schedule (Seconds (8), &GridSpatialIndexTest::CheckCandidates, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  m_index->Clear ();
+  NS_TEST_EXPECT_MSG_EQ (m_index->GetN (), 0, "Unexpected number of items");
+  m_mobilities.clear ();
+}
+
+/**
+ * \ingroup mobility-test
+ * \ingroup tests
+ *
+ * \brief Grid Spatial Index Test Suite
+ */
+class GridSpatialIndexTestSuite : public TestSuite
+{
+public:
+  GridSpatialIndexTestSuite ();
+};
+
+GridSpatialIndexTestSuite::GridSpatialIndexTestSuite ()
+  : TestSuite ("grid-spatial-index", UNIT)
+{
+  AddTestCase (new GridSpatialIndexTest, TestCase::QUICK);
+}
+
+static GridSpatialIndexTestSuite g_gridSpatialIndexTestSuite; ///< the test suite
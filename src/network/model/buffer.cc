@@ -18,9 +18,12 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "buffer.h"
+#include "packet-arena.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+
 #define LOG_INTERNAL_STATE(y)                                                                    \
   NS_LOG_LOGIC (y << "start="<<m_start<<", end="<<m_end<<", zero start="<<m_zeroAreaStart<<              \
                 ", zero end="<<m_zeroAreaEnd<<", count="<<m_data->m_count<<", size="<<m_data->m_size<<   \
@@ -50,114 +53,33 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 
-uint32_t Buffer::g_recommendedStart = 0;
+thread_local uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use 
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy 
- * constructor orderings.
- */
-#define MAGIC_DESTROYED (~(long) 0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED (x) && !IS_DESTROYED (x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList *Buffer::g_freeList = 0;
-struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
-
-Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
-{
-  NS_LOG_FUNCTION (this);
-  if (IS_INITIALIZED (g_freeList))
-    {
-      for (Buffer::FreeList::iterator i = g_freeList->begin ();
-           i != g_freeList->end (); i++)
-        {
-          Buffer::Deallocate (*i);
-        }
-      delete g_freeList;
-      g_freeList = DESTROYED;
-    }
-}
+thread_local uint32_t Buffer::g_maxSize = 0;
+#endif /* BUFFER_FREE_LIST */
 
 void
 Buffer::Recycle (struct Buffer::Data *data)
 {
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
-  NS_ASSERT (!IS_UNINITIALIZED (g_freeList));
+#ifdef BUFFER_FREE_LIST
   g_maxSize = std::max (g_maxSize, data->m_size);
-  /* feed into free list */
-  if (data->m_size < g_maxSize ||
-      IS_DESTROYED (g_freeList) ||
-      g_freeList->size () > 1000)
-    {
-      Buffer::Deallocate (data);
-    }
-  else
-    {
-      NS_ASSERT (IS_INITIALIZED (g_freeList));
-      g_freeList->push_back (data);
-    }
+#endif /* BUFFER_FREE_LIST */
+  Deallocate (data);
 }
 
 Buffer::Data *
 Buffer::Create (uint32_t dataSize)
 {
   NS_LOG_FUNCTION (dataSize);
-  /* try to find a buffer correctly sized. */
-  if (IS_UNINITIALIZED (g_freeList))
-    {
-      g_freeList = new Buffer::FreeList ();
-    }
-  else if (IS_INITIALIZED (g_freeList))
-    {
-      while (!g_freeList->empty ()) 
-        {
-          struct Buffer::Data *data = g_freeList->back ();
-          g_freeList->pop_back ();
-          if (data->m_size >= dataSize) 
-            {
-              data->m_count = 1;
-              return data;
-            }
-          Buffer::Deallocate (data);
-        }
-    }
-  struct Buffer::Data *data = Buffer::Allocate (dataSize);
-  NS_ASSERT (data->m_count == 1);
-  return data;
-}
-#else /* BUFFER_FREE_LIST */
-void
-Buffer::Recycle (struct Buffer::Data *data)
-{
-  NS_LOG_FUNCTION (data);
-  NS_ASSERT (data->m_count == 0);
-  Deallocate (data);
-}
-
-Buffer::Data *
-Buffer::Create (uint32_t size)
-{
-  NS_LOG_FUNCTION (size);
-  return Allocate (size);
-}
+#ifdef BUFFER_FREE_LIST
+  // allocate buffers large enough for the largest buffer released by the
+  // thread, so that they are seldom resized
+  dataSize = std::max (dataSize, g_maxSize);
 #endif /* BUFFER_FREE_LIST */
+  return Allocate (dataSize);
+}
 
 struct Buffer::Data *
 Buffer::Allocate (uint32_t reqSize)
@@ -169,9 +91,16 @@ Buffer::Allocate (uint32_t reqSize)
     }
   NS_ASSERT (reqSize >= 1);
   uint32_t size = reqSize - 1 + sizeof (struct Buffer::Data);
+#ifdef BUFFER_FREE_LIST
+  // the data is not initialized: the bytes which were not written are
+  // in the virtual zero area
+  size = PacketArena::GetCapacity (size);
+  uint8_t *b = static_cast<uint8_t *> (PacketArena::Allocate (size));
+#else /* BUFFER_FREE_LIST */
   uint8_t *b = new uint8_t [size];
+#endif /* BUFFER_FREE_LIST */
   struct Buffer::Data *data = reinterpret_cast<struct Buffer::Data*>(b);
-  data->m_size = reqSize;
+  data->m_size = size + 1 - sizeof (struct Buffer::Data);
   data->m_count = 1;
   return data;
 }
@@ -182,7 +111,11 @@ Buffer::Deallocate (struct Buffer::Data *data)
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
   uint8_t *buf = reinterpret_cast<uint8_t *> (data);
+#ifdef BUFFER_FREE_LIST
+  PacketArena::Deallocate (buf, data->m_size - 1 + sizeof (struct Buffer::Data));
+#else /* BUFFER_FREE_LIST */
   delete [] buf;
+#endif /* BUFFER_FREE_LIST */
 }
 
 Buffer::Buffer ()
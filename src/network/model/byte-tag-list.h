@@ -213,6 +213,12 @@ private:
    */
   inline void Adjust (int32_t adjustment);
 
+  /**
+   * \returns true if the list holds no tag. The offsets of an empty list
+   *          need not be adjusted.
+   */
+  inline bool IsEmpty (void) const;
+
   /**
    * Make sure that all offsets are smaller than appendOffset which represents
    * the location where new bytes have been added to the byte buffer.
@@ -288,6 +294,12 @@ ByteTagList::Adjust (int32_t adjustment)
   m_adjustment += adjustment;
 }
 
+bool
+ByteTagList::IsEmpty (void) const
+{
+  return m_data == 0;
+}
+
 } // namespace ns3
 
 #endif /* BYTE_TAG_LIST_H */
@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "packet-arena.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <new>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PacketArena");
+
+namespace {
+
+/** The maximum number of free blocks kept by a pool. */
+const uint32_t MAX_FREE_BLOCKS = 1024;
+/** The maximum size of the free blocks kept by a pool, in bytes. */
+const uint32_t MAX_FREE_BYTES = 1 << 20;
+
+/** A free block, linked to the next free block of its pool. */
+struct FreeBlock
+{
+  FreeBlock *next; //!< The next free block
+};
+
+/**
+ * The pools of a thread.
+ *
+ * This structure is trivially destructible, so that it can still be
+ * checked by the blocks freed after the thread has released its pools
+ * (e.g., by the destructors of static objects).
+ */
+struct Arena
+{
+  FreeBlock *free[PacketArena::POOLS];   //!< The free blocks of each pool
+  uint32_t count[PacketArena::POOLS];    //!< The number of free blocks of each pool
+  PacketArena::Stats stats;              //!< The statistics of the pools
+  bool registered;                       //!< Whether the ArenaReleaser is registered
+  bool released;                         //!< Whether the free blocks were released
+};
+
+/** The pools of the thread. */
+thread_local Arena g_arena;
+
+/** Releases the free blocks of a thread when it exits. */
+struct ArenaReleaser
+{
+  /** Make sure that the releaser of the thread is constructed. */
+  void Register (void);
+  /** Release the free blocks of the thread. */
+  ~ArenaReleaser ();
+};
+
+/** The releaser of the pools of the thread. */
+thread_local ArenaReleaser g_arenaReleaser;
+
+void
+ArenaReleaser::Register (void)
+{
+  g_arena.registered = true;
+}
+
+ArenaReleaser::~ArenaReleaser ()
+{
+  Arena &arena = g_arena;
+  for (uint32_t i = 0; i < PacketArena::POOLS; i++)
+    {
+      while (arena.free[i] != 0)
+        {
+          FreeBlock *block = arena.free[i];
+          arena.free[i] = block->next;
+          ::operator delete (block);
+        }
+      arena.count[i] = 0;
+    }
+  arena.released = true;
+}
+
+/**
+ * \param [in] size A size no larger than PacketArena::MAX_BLOCK_SIZE.
+ * \returns The index of the pool of the blocks of that size.
+ */
+inline uint32_t
+GetPool (uint32_t size)
+{
+  uint32_t pool = 0;
+  uint32_t blockSize = PacketArena::MIN_BLOCK_SIZE;
+  while (blockSize < size)
+    {
+      blockSize <<= 1;
+      pool++;
+    }
+  return pool;
+}
+
+/**
+ * \param [in] pool The index of a pool.
+ * \returns The size of the blocks of the pool.
+ */
+inline uint32_t
+GetBlockSize (uint32_t pool)
+{
+  return PacketArena::MIN_BLOCK_SIZE << pool;
+}
+
+} // unnamed namespace
+
+uint32_t
+PacketArena::GetCapacity (uint32_t size)
+{
+  if (size > MAX_BLOCK_SIZE)
+    {
+      return size;
+    }
+  return GetBlockSize (GetPool (size));
+}
+
+void *
+PacketArena::Allocate (uint32_t size)
+{
+  Arena &arena = g_arena;
+  if (size > MAX_BLOCK_SIZE)
+    {
+      arena.stats.large++;
+      return ::operator new (size);
+    }
+  uint32_t pool = GetPool (size);
+  arena.stats.pools[pool].allocations++;
+  FreeBlock *block = arena.free[pool];
+  if (block != 0)
+    {
+      arena.free[pool] = block->next;
+      arena.count[pool]--;
+      arena.stats.pools[pool].reused++;
+      return block;
+    }
+  if (!arena.registered)
+    {
+      g_arenaReleaser.Register ();
+    }
+  return ::operator new (GetBlockSize (pool));
+}
+
+void
+PacketArena::Deallocate (void *p, uint32_t size)
+{
+  if (size > MAX_BLOCK_SIZE)
+    {
+      ::operator delete (p);
+      return;
+    }
+  Arena &arena = g_arena;
+  uint32_t pool = GetPool (size);
+  uint32_t blockSize = GetBlockSize (pool);
+  // only the threads which registered their releaser keep free blocks
+  if (!arena.registered || arena.released
+      || arena.count[pool] >= std::min (MAX_FREE_BLOCKS, MAX_FREE_BYTES / blockSize))
+    {
+      ::operator delete (p);
+      return;
+    }
+  FreeBlock *block = static_cast<FreeBlock *> (p);
+  block->next = arena.free[pool];
+  arena.free[pool] = block;
+  arena.count[pool]++;
+  PoolStats &stats = arena.stats.pools[pool];
+  stats.maxFree = std::max (stats.maxFree, arena.count[pool]);
+}
+
+PacketArena::Stats
+PacketArena::GetStats (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  Stats stats = g_arena.stats;
+  for (uint32_t i = 0; i < POOLS; i++)
+    {
+      stats.pools[i].blockSize = GetBlockSize (i);
+      stats.pools[i].free = g_arena.count[i];
+    }
+  return stats;
+}
+
+std::ostream &
+operator << (std::ostream &os, const PacketArena::Stats &stats)
+{
+  for (uint32_t i = 0; i < PacketArena::POOLS; i++)
+    {
+      const PacketArena::PoolStats &pool = stats.pools[i];
+      os << "blockSize=" << pool.blockSize
+         << " allocations=" << pool.allocations
+         << " reused=" << pool.reused
+         << " free=" << pool.free
+         << " maxFree=" << pool.maxFree << std::endl;
+    }
+  os << "large=" << stats.large;
+  return os;
+}
+
+} // namespace ns3
@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#ifndef PACKET_ARENA_H
+#define PACKET_ARENA_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <ostream>
+
+namespace ns3 {
+
+/**
+ * \ingroup packet
+ *
+ * \brief Per-thread pools of the memory blocks of the packets
+ *
+ * The packets (Packet), the data of their buffers (Buffer), their
+ * metadata (PacketMetadata) and their tag lists (ByteTagList and
+ * PacketTagList) are allocated from the same arena. The arena rounds
+ * the requested sizes up to a power of two between MIN_BLOCK_SIZE and
+ * MAX_BLOCK_SIZE, and keeps a pool of the free blocks of each size, so
+ * that the memory of the packets released by a simulation is reused by
+ * the next packets without calling the system allocator. The larger
+ * blocks are allocated and freed directly.
+ *
+ * Each thread has its own pools, which it uses without any locking: a
+ * block may be freed by a thread other than the one which allocated it
+ * (e.g., a packet sent across the partitions of a multithreaded
+ * simulation), since every block is allocated separately. The number of
+ * free blocks kept by each pool is bounded, and the free blocks of a
+ * thread are released when it exits.
+ */
+class PacketArena
+{
+public:
+  /** The size of the smallest blocks, in bytes. */
+  static const uint32_t MIN_BLOCK_SIZE = 32;
+  /** The size of the largest blocks kept in pools, in bytes. */
+  static const uint32_t MAX_BLOCK_SIZE = 8192;
+  /** The number of pools, i.e., of block sizes. */
+  static const uint32_t POOLS = 9;
+
+  /** The statistics of a pool of a thread. */
+  struct PoolStats
+  {
+    uint32_t blockSize;   //!< The size of the blocks, in bytes
+    uint32_t free;        //!< The number of free blocks in the pool
+    uint32_t maxFree;     //!< The highest number of free blocks in the pool
+    uint64_t allocations; //!< The number of blocks allocated
+    uint64_t reused;      //!< The number of allocations served by the pool
+  };
+
+  /** The statistics of the arena of a thread. */
+  struct Stats
+  {
+    PoolStats pools[POOLS]; //!< The statistics of each pool
+    uint64_t large;         //!< The number of blocks larger than MAX_BLOCK_SIZE allocated
+  };
+
+  /**
+   * \param [in] size A requested size, in bytes.
+   * \returns The size of the block allocated for that size, i.e., the
+   *          memory actually available to the caller.
+   */
+  static uint32_t GetCapacity (uint32_t size);
+  /**
+   * Allocate a block.
+   *
+   * \param [in] size The requested size, in bytes.
+   * \returns A block of GetCapacity(size) bytes, uninitialized.
+   */
+  static void * Allocate (uint32_t size);
+  /**
+   * Free a block, which is kept by the pool of the calling thread if
+   * it is not full.
+   *
+   * \param [in] p The block.
+   * \param [in] size The size requested for the block, or its capacity.
+   */
+  static void Deallocate (void *p, uint32_t size);
+  /**
+   * \returns The statistics of the arena of the calling thread.
+   */
+  static Stats GetStats (void);
+};
+
+/**
+ * \ingroup packet
+ * Print the statistics of an arena, one pool per line.
+ *
+ * \param [in,out] os The output stream.
+ * \param [in] stats The statistics.
+ * \returns The output stream.
+ */
+std::ostream & operator << (std::ostream &os, const PacketArena::Stats &stats);
+
+} // namespace ns3
+
+#endif /* PACKET_ARENA_H */
@@ -23,6 +23,7 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 #include "packet-metadata.h"
+#include "packet-arena.h"
 #include "buffer.h"
 #include "header.h"
 #include "trailer.h"
@@ -34,19 +35,9 @@ NS_LOG_COMPONENT_DEFINE ("PacketMetadata");
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
-uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
-
-PacketMetadata::DataFreeList::~DataFreeList ()
-{
-  NS_LOG_FUNCTION (this);
-  for (iterator i = begin (); i != end (); i++)
-    {
-      PacketMetadata::Deallocate (*i);
-    }
-  PacketMetadata::m_enable = false;
-}
+bool PacketMetadata::m_disabled = false;
+thread_local uint32_t PacketMetadata::m_maxSize = 0;
+thread_local uint16_t PacketMetadata::m_chunkUid = 0;
 
 void 
 PacketMetadata::Enable (void)
@@ -60,6 +51,7 @@ PacketMetadata::Enable (void)
                  "to call ns3::PacketMetadata::Enable () near the beginning of"
                  " the program, before any packets are sent.");
   m_enable = true;
+  m_disabled = false;
 }
 
 void 
@@ -70,6 +62,24 @@ PacketMetadata::EnableChecking (void)
   m_enableChecking = true;
 }
 
+void
+PacketMetadata::Disable (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  if (m_enable)
+    {
+      NS_LOG_LOGIC ("the packet metadata is enabled: not disabling it");
+      return;
+    }
+  m_disabled = true;
+}
+
+bool
+PacketMetadata::IsDisabled (void)
+{
+  return m_disabled;
+}
+
 void
 PacketMetadata::ReserveCopy (uint32_t size)
 {
@@ -133,6 +143,10 @@ bool
 PacketMetadata::IsStateOk (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_data == 0)
+    {
+      return m_head == 0xffff && m_tail == 0xffff && m_used == 0;
+    }
   bool ok = m_used <= m_data->m_size;
   ok &= IsPointerOk (m_head);
   ok &= IsPointerOk (m_tail);
@@ -575,20 +589,6 @@ PacketMetadata::Create (uint32_t size)
     {
       m_maxSize = size;
     }
-  while (!m_freeList.empty ()) 
-    {
-      struct PacketMetadata::Data *data = m_freeList.back ();
-      m_freeList.pop_back ();
-      if (data->m_size >= size) 
-        {
-          NS_LOG_LOGIC ("create found size="<<data->m_size);
-          data->m_count = 1;
-          return data;
-        }
-      NS_LOG_LOGIC ("create dealloc size="<<data->m_size);
-      PacketMetadata::Deallocate (data);
-    }
-  NS_LOG_LOGIC ("create alloc size="<<m_maxSize);
   return PacketMetadata::Allocate (m_maxSize);
 }
 
@@ -596,22 +596,8 @@ void
 PacketMetadata::Recycle (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  if (!m_enable)
-    {
-      PacketMetadata::Deallocate (data);
-      return;
-    } 
-  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<m_freeList.size ());
   NS_ASSERT (data->m_count == 0);
-  if (m_freeList.size () > 1000 ||
-      data->m_size < m_maxSize) 
-    {
-      PacketMetadata::Deallocate (data);
-    } 
-  else 
-    {
-      m_freeList.push_back (data);
-    }
+  PacketMetadata::Deallocate (data);
 }
 
 struct PacketMetadata::Data *
@@ -624,9 +610,10 @@ PacketMetadata::Allocate (uint32_t n)
       n = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
   size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-  uint8_t *buf = new uint8_t [size];
+  size = PacketArena::GetCapacity (size);
+  uint8_t *buf = static_cast<uint8_t *> (PacketArena::Allocate (size));
   struct PacketMetadata::Data *data = (struct PacketMetadata::Data *)buf;
-  data->m_size = n;
+  data->m_size = size - sizeof (struct Data) + PACKET_METADATA_DATA_M_DATA_SIZE;
   data->m_count = 1;
   data->m_dirtyEnd = 0;
   return data;
@@ -635,8 +622,7 @@ void
 PacketMetadata::Deallocate (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  uint8_t *buf = (uint8_t *)data;
-  delete [] buf;
+  PacketArena::Deallocate (data, sizeof (struct Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE);
 }
 
 
@@ -655,6 +641,11 @@ PacketMetadata::AddHeader (const Header &header, uint32_t size)
 {
   NS_LOG_FUNCTION (this << &header << size);
   NS_ASSERT (IsStateOk ());
+  if (!m_enable)
+    {
+      MetadataSkipped ();
+      return;
+    }
   uint32_t uid = header.GetInstanceTypeId ().GetUid () << 1;
   DoAddHeader (uid, size);
   NS_ASSERT (IsStateOk ());
@@ -665,7 +656,7 @@ PacketMetadata::DoAddHeader (uint32_t uid, uint32_t size)
   NS_LOG_FUNCTION (this << uid << size);
   if (!m_enable)
     {
-      m_metadataSkipped = true;
+      MetadataSkipped ();
       return;
     }
 
@@ -682,14 +673,14 @@ PacketMetadata::DoAddHeader (uint32_t uid, uint32_t size)
 void 
 PacketMetadata::RemoveHeader (const Header &header, uint32_t size)
 {
-  uint32_t uid = header.GetInstanceTypeId ().GetUid () << 1;
   NS_LOG_FUNCTION (this << &header << size);
   NS_ASSERT (IsStateOk ());
   if (!m_enable) 
     {
-      m_metadataSkipped = true;
+      MetadataSkipped ();
       return;
     }
+  uint32_t uid = header.GetInstanceTypeId ().GetUid () << 1;
   struct PacketMetadata::SmallItem item;
   struct PacketMetadata::ExtraItem extraItem;
   uint32_t read = ReadItems (m_head, &item, &extraItem);
@@ -730,14 +721,14 @@ PacketMetadata::RemoveHeader (const Header &header, uint32_t size)
 void 
 PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
 {
-  uint32_t uid = trailer.GetInstanceTypeId ().GetUid () << 1;
   NS_LOG_FUNCTION (this << &trailer << size);
   NS_ASSERT (IsStateOk ());
   if (!m_enable)
     {
-      m_metadataSkipped = true;
+      MetadataSkipped ();
       return;
     }
+  uint32_t uid = trailer.GetInstanceTypeId ().GetUid () << 1;
   struct PacketMetadata::SmallItem item;
   item.next = 0xffff;
   item.prev = m_tail;
@@ -752,14 +743,14 @@ PacketMetadata::AddTrailer (const Trailer &trailer, uint32_t size)
 void 
 PacketMetadata::RemoveTrailer (const Trailer &trailer, uint32_t size)
 {
-  uint32_t uid = trailer.GetInstanceTypeId ().GetUid () << 1;
   NS_LOG_FUNCTION (this << &trailer << size);
   NS_ASSERT (IsStateOk ());
   if (!m_enable) 
     {
-      m_metadataSkipped = true;
+      MetadataSkipped ();
       return;
     }
+  uint32_t uid = trailer.GetInstanceTypeId ().GetUid () << 1;
   struct PacketMetadata::SmallItem item;
   struct PacketMetadata::ExtraItem extraItem;
   uint32_t read = ReadItems (m_tail, &item, &extraItem);
@@ -804,7 +795,7 @@ PacketMetadata::AddAtEnd (PacketMetadata const&o)
   NS_ASSERT (IsStateOk ());
   if (!m_enable) 
     {
-      m_metadataSkipped = true;
+      MetadataSkipped ();
       return;
     }
   if (m_tail == 0xffff)
@@ -881,7 +872,7 @@ PacketMetadata::AddPaddingAtEnd (uint32_t end)
   NS_LOG_FUNCTION (this << end);
   if (!m_enable)
     {
-      m_metadataSkipped = true;
+      MetadataSkipped ();
       return;
     }
 }
@@ -892,7 +883,7 @@ PacketMetadata::RemoveAtStart (uint32_t start)
   NS_ASSERT (IsStateOk ());
   if (!m_enable) 
     {
-      m_metadataSkipped = true;
+      MetadataSkipped ();
       return;
     }
   NS_ASSERT (m_data != 0);
@@ -955,7 +946,7 @@ PacketMetadata::RemoveAtEnd (uint32_t end)
   NS_ASSERT (IsStateOk ());
   if (!m_enable) 
     {
-      m_metadataSkipped = true;
+      MetadataSkipped ();
       return;
     }
   NS_ASSERT (m_data != 0);
@@ -1046,6 +1037,13 @@ PacketMetadata::ItemIterator
 PacketMetadata::BeginItem (Buffer buffer) const
 {
   NS_LOG_FUNCTION (this << &buffer);
+  if (m_disabled)
+    {
+      NS_FATAL_ERROR ("Cannot print or iterate over the headers and trailers of a packet: "
+                      "the packet metadata was disabled by Packet::DisableMetadata. "
+                      "Call Packet::EnablePrinting or Packet::EnableChecking instead, "
+                      "before any packet is created.");
+    }
   return ItemIterator (this, buffer);
 }
 PacketMetadata::ItemIterator::ItemIterator (const PacketMetadata *metadata, Buffer buffer)
@@ -1329,8 +1327,11 @@ PacketMetadata::Deserialize (const uint8_t* buffer, uint32_t size)
                     ", size="<<item.size<<", chunkUid="<<item.chunkUid<<
                     ", fragmentStart="<<extraItem.fragmentStart<<", fragmentEnd="<<
                     extraItem.fragmentEnd<< ", packetUid="<<extraItem.packetUid);
-      uint32_t tmp = AddBig (0xffff, m_tail, &item, &extraItem);
-      UpdateTail (tmp);
+      if (m_data != 0)
+        {
+          uint32_t tmp = AddBig (0xffff, m_tail, &item, &extraItem);
+          UpdateTail (tmp);
+        }
     }
   NS_ASSERT (desSize == 0);
   return (desSize !=0) ? 0 : 1;
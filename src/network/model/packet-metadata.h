@@ -160,6 +160,20 @@ private:
    * \brief Enable the packet metadata checking
    */
   static void EnableChecking (void);
+  /**
+   * \brief Disable the packet metadata altogether
+   *
+   * The packets created afterwards have no metadata storage at all, and
+   * their headers and trailers are not recorded, even as skipped. This
+   * has no effect if the metadata is already enabled: Enable and
+   * EnableChecking take precedence, and clear this mode if called
+   * afterwards.
+   */
+  static void Disable (void);
+  /**
+   * \returns true if the metadata was disabled by Disable.
+   */
+  static bool IsDisabled (void);
 
   /**
    * \brief Constructor
@@ -494,16 +508,6 @@ private:
     uint64_t packetUid;
   };
 
-  /**
-   * \brief Class to hold all the metadata
-   */
-  class DataFreeList : public std::vector<struct Data *>
-  {
-public:
-    ~DataFreeList ();
-  };
-
-  friend DataFreeList::~DataFreeList ();
   /// Friend class
   friend class ItemIterator;
 
@@ -661,7 +665,6 @@ public:
    */
   static void Deallocate (struct PacketMetadata::Data *data);
 
-  static DataFreeList m_freeList; //!< the metadata data storage
   static bool m_enable; //!< Enable the packet metadata
   static bool m_enableChecking; //!< Enable the packet metadata checking
 
@@ -671,11 +674,22 @@ public:
    * middle of a simulation, which isn't allowed.
    */
   static bool m_metadataSkipped;
+  /**
+   * Set by Disable: the packets have no metadata storage, and the
+   * skipped operations are not recorded in m_metadataSkipped.
+   */
+  static bool m_disabled;
+
+  /**
+   * Record that adding metadata to a packet was skipped, unless the
+   * metadata is disabled.
+   */
+  static inline void MetadataSkipped (void);
 
-  static uint32_t m_maxSize; //!< maximum metadata size
-  static uint16_t m_chunkUid; //!< Chunk Uid
+  static thread_local uint32_t m_maxSize; //!< maximum metadata size
+  static thread_local uint16_t m_chunkUid; //!< Chunk Uid
 
-  struct Data *m_data; //!< Metadata storage
+  struct Data *m_data; //!< Metadata storage, null if the metadata is disabled
   /*
      head -(next)-> tail
        ^             |
@@ -691,13 +705,26 @@ public:
 
 namespace ns3 {
 
+void
+PacketMetadata::MetadataSkipped (void)
+{
+  if (!m_disabled)
+    {
+      m_metadataSkipped = true;
+    }
+}
+
 PacketMetadata::PacketMetadata (uint64_t uid, uint32_t size)
-  : m_data (PacketMetadata::Create (10)),
+  : m_data (m_disabled ? 0 : PacketMetadata::Create (10)),
     m_head (0xffff),
     m_tail (0xffff),
     m_used (0),
     m_packetUid (uid)
 {
+  if (m_data == 0)
+    {
+      return;
+    }
   memset (m_data->m_data, 0xff, 4);
   if (size > 0)
     {
@@ -711,9 +738,11 @@ PacketMetadata::PacketMetadata (PacketMetadata const &o)
     m_used (o.m_used),
     m_packetUid (o.m_packetUid)
 {
-  NS_ASSERT (m_data != 0);
-  NS_ASSERT (m_data->m_count < std::numeric_limits<uint32_t>::max());
-  m_data->m_count++;
+  if (m_data != 0)
+    {
+      NS_ASSERT (m_data->m_count < std::numeric_limits<uint32_t>::max());
+      m_data->m_count++;
+    }
 }
 PacketMetadata &
 PacketMetadata::operator = (PacketMetadata const& o)
@@ -721,15 +750,19 @@ PacketMetadata::operator = (PacketMetadata const& o)
   if (m_data != o.m_data) 
     {
       // not self assignment
-      NS_ASSERT (m_data != 0);
-      m_data->m_count--;
-      if (m_data->m_count == 0) 
+      if (m_data != 0)
         {
-          PacketMetadata::Recycle (m_data);
+          m_data->m_count--;
+          if (m_data->m_count == 0) 
+            {
+              PacketMetadata::Recycle (m_data);
+            }
         }
       m_data = o.m_data;
-      NS_ASSERT (m_data != 0);
-      m_data->m_count++;
+      if (m_data != 0)
+        {
+          m_data->m_count++;
+        }
     }
   m_head = o.m_head;
   m_tail = o.m_tail;
@@ -739,7 +772,10 @@ PacketMetadata::operator = (PacketMetadata const& o)
 }
 PacketMetadata::~PacketMetadata ()
 {
-  NS_ASSERT (m_data != 0);
+  if (m_data == 0)
+    {
+      return;
+    }
   m_data->m_count--;
   if (m_data->m_count == 0) 
     {
@@ -43,7 +43,7 @@ PacketTagList::CreateTagData (size_t dataSize)
                  << " exceeds maximum "
                  << std::numeric_limits<decltype(TagData::size)>::max () );
 
-  void * p = std::malloc (sizeof (TagData) + dataSize - 1);
+  void * p = PacketArena::Allocate (sizeof (TagData) + dataSize - 1);
   // The matching frees are in RemoveAll and RemoveWriter
 
   TagData * tag = new (p) TagData;
@@ -194,8 +194,7 @@ PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
   if (preMerge)
     {
       // found tid before first merge, so delete cur
-      cur->~TagData ();
-      std::free (cur);
+      DestroyTagData (cur);
     }
   else
     {
@@ -28,6 +28,7 @@
 #include <stdint.h>
 #include <ostream>
 #include "ns3/type-id.h"
+#include "packet-arena.h"
 
 namespace ns3 {
 
@@ -252,6 +253,13 @@ private:
    */
   static
   TagData * CreateTagData (size_t dataSize);
+  /**
+   * Destroy and free a TagData struct allocated by CreateTagData.
+   *
+   * \param [in] tag The TagData object.
+   */
+  static inline
+  void DestroyTagData (TagData *tag);
   
   /**
    * Typedef of method function pointer for copy-on-write operations
@@ -352,6 +360,14 @@ PacketTagList::~PacketTagList ()
   RemoveAll ();
 }
 
+inline void
+PacketTagList::DestroyTagData (TagData *tag)
+{
+  uint32_t size = sizeof (TagData) + tag->size - 1;
+  tag->~TagData ();
+  PacketArena::Deallocate (tag, size);
+}
+
 void
 PacketTagList::RemoveAll (void)
 {
@@ -365,15 +381,13 @@ PacketTagList::RemoveAll (void)
         }
       if (prev != 0) 
         {
-          prev->~TagData ();
-          std::free (prev);
+          DestroyTagData (prev);
         }
       prev = cur;
     }
   if (prev != 0) 
     {
-      prev->~TagData ();
-      std::free (prev);
+      DestroyTagData (prev);
     }
   m_next = 0;
 }
@@ -28,7 +28,7 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+thread_local uint32_t Packet::m_globalUid = 0;
 
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
@@ -126,6 +126,18 @@ Packet::Copy (void) const
   return Ptr<Packet> (new Packet (*this), false);
 }
 
+void *
+Packet::operator new (std::size_t size)
+{
+  return PacketArena::Allocate (size);
+}
+
+void
+Packet::operator delete (void *p, std::size_t size)
+{
+  PacketArena::Deallocate (p, size);
+}
+
 Packet::Packet ()
   : m_buffer (),
     m_byteTagList (),
@@ -258,8 +270,11 @@ Packet::AddHeader (const Header &header)
   uint32_t size = header.GetSerializedSize ();
   NS_LOG_FUNCTION (this << header.GetInstanceTypeId ().GetName () << size);
   m_buffer.AddAtStart (size);
-  m_byteTagList.Adjust (size);
-  m_byteTagList.AddAtStart (size);
+  if (!PacketMetadata::IsDisabled () || !m_byteTagList.IsEmpty ())
+    {
+      m_byteTagList.Adjust (size);
+      m_byteTagList.AddAtStart (size);
+    }
   header.Serialize (m_buffer.Begin ());
   m_metadata.AddHeader (header, size);
 }
@@ -572,6 +587,9 @@ void
 Packet::EnablePrinting (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
+  NS_ABORT_MSG_IF (PacketMetadata::IsDisabled () && m_globalUid > 0,
+                   "Packet::EnablePrinting called after Packet::DisableMetadata "
+                   "and after packets were created: call it before any packet is created.");
   PacketMetadata::Enable ();
 }
 
@@ -579,9 +597,19 @@ void
 Packet::EnableChecking (void)
 {
   NS_LOG_FUNCTION_NOARGS ();
+  NS_ABORT_MSG_IF (PacketMetadata::IsDisabled () && m_globalUid > 0,
+                   "Packet::EnableChecking called after Packet::DisableMetadata "
+                   "and after packets were created: call it before any packet is created.");
   PacketMetadata::EnableChecking ();
 }
 
+void
+Packet::DisableMetadata (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  PacketMetadata::Disable ();
+}
+
 uint32_t Packet::GetSerializedSize (void) const
 {
   uint32_t size = 0;
@@ -28,6 +28,7 @@
 #include "tag.h"
 #include "byte-tag-list.h"
 #include "packet-tag-list.h"
+#include "packet-arena.h"
 #include "nix-vector.h"
 #include "ns3/mac48-address.h"
 #include "ns3/callback.h"
@@ -284,6 +285,20 @@ public:
    * \param size the size of the input buffer.
    */
   Packet (uint8_t const*buffer, uint32_t size);
+  /**
+   * \brief Allocate the memory of a packet from the PacketArena.
+   *
+   * \param size the size of the packet object
+   * \returns the memory of the packet
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * \brief Free the memory of a packet to the PacketArena.
+   *
+   * \param p the memory of the packet
+   * \param size the size of the packet object
+   */
+  static void operator delete (void *p, std::size_t size);
   /**
    * \brief Create a new packet which contains a fragment of the original
    * packet.
@@ -530,6 +545,26 @@ public:
    * errors will be detected and will abort the program.
    */
   static void EnableChecking (void);
+  /**
+   * \brief Disable packets metadata altogether.
+   *
+   * Even when it is not enabled, the metadata of each packet is
+   * allocated and the headers and trailers added to and removed from
+   * the packets are looked up and recorded as skipped, to detect a late
+   * call to EnablePrinting. Large simulations which never print packets
+   * can avoid this cost with this method, which must be called during
+   * the simulation setup and before any packet is created. Neither
+   * the metadata nor, for the packets without byte tags, the byte tag
+   * offsets are updated by the headers added afterwards, and Print and
+   * BeginItem abort the program with an error.
+   *
+   * This method has no effect if EnablePrinting or EnableChecking was
+   * already called, and calling either of them afterwards, before any
+   * packet is created, enables the metadata again: a simulation script
+   * can thus disable the metadata while still allowing validation runs
+   * to enable checking (e.g., from the command line).
+   */
+  static void DisableMetadata (void);
 
   /**
    * \brief Returns number of bytes required for packet
@@ -787,7 +822,7 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-  static uint32_t m_globalUid; //!< Global counter of packets Uid
+  static thread_local uint32_t m_globalUid; //!< Counter of packets Uid of the thread (i.e., of the system)
 };
 
 /**
@@ -19,6 +19,7 @@
  */
 #include "ns3/packet.h"
 #include "ns3/packet-tag-list.h"
+#include "ns3/packet-arena.h"
 #include "ns3/test.h"
 #include "ns3/unused.h"
 #include <limits>     // std:numeric_limits
@@ -1158,6 +1159,66 @@ PacketTagListTest::DoRun (void)
     
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Packet arena unit tests.
+ */
+class PacketArenaTest : public TestCase
+{
+public:
+  PacketArenaTest ();
+private:
+  void DoRun (void);
+};
+
+PacketArenaTest::PacketArenaTest ()
+  : TestCase ("PacketArena")
+{
+}
+
+void
+PacketArenaTest::DoRun (void)
+{
+  NS_TEST_EXPECT_MSG_EQ (PacketArena::GetCapacity (1), 32u, "smallest block");
+  NS_TEST_EXPECT_MSG_EQ (PacketArena::GetCapacity (32), 32u, "exact block size");
+  NS_TEST_EXPECT_MSG_EQ (PacketArena::GetCapacity (33), 64u, "rounded up block size");
+  NS_TEST_EXPECT_MSG_EQ (PacketArena::GetCapacity (8192), 8192u, "largest block");
+  NS_TEST_EXPECT_MSG_EQ (PacketArena::GetCapacity (8193), 8193u, "large block");
+
+  // a freed block is reused by the next allocation of the same size
+  PacketArena::Stats before = PacketArena::GetStats ();
+  void *p = PacketArena::Allocate (100);
+  PacketArena::Deallocate (p, 100);
+  void *q = PacketArena::Allocate (128);
+  NS_TEST_EXPECT_MSG_EQ (p, q, "block not reused");
+  PacketArena::Deallocate (q, 128);
+  PacketArena::Stats after = PacketArena::GetStats ();
+  NS_TEST_EXPECT_MSG_EQ (after.pools[2].blockSize, 128u, "wrong block size");
+  NS_TEST_EXPECT_MSG_EQ (after.pools[2].allocations - before.pools[2].allocations, 2u, "wrong allocation count");
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (after.pools[2].reused - before.pools[2].reused, 1u, "wrong reuse count");
+  NS_TEST_EXPECT_MSG_GT (after.pools[2].free, 0u, "no free block");
+
+  // the packets, their buffers and their tags are allocated from the arena
+  before = PacketArena::GetStats ();
+  {
+    Ptr<Packet> packet = Create<Packet> (1000);
+    ATestTag<10> tag;
+    packet->AddPacketTag (tag);
+    packet->AddByteTag (tag);
+    uint8_t data[100] = {0};
+    packet->AddAtEnd (Create<Packet> (data, sizeof (data)));
+  }
+  after = PacketArena::GetStats ();
+  uint64_t allocations = 0;
+  for (uint32_t i = 0; i < PacketArena::POOLS; i++)
+    {
+      allocations += after.pools[i].allocations - before.pools[i].allocations;
+    }
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (allocations, 5u, "packets not allocated from the arena");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1175,6 +1236,7 @@ PacketTestSuite::PacketTestSuite ()
 {
   AddTestCase (new PacketTest, TestCase::QUICK);
   AddTestCase (new PacketTagListTest, TestCase::QUICK);
+  AddTestCase (new PacketArenaTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
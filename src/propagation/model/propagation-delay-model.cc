@@ -22,6 +22,8 @@
 #include "ns3/double.h"
 #include "ns3/string.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
 
 namespace ns3 {
 
@@ -130,5 +132,108 @@ ConstantSpeedPropagationDelayModel::DoAssignStreams (int64_t stream)
   return 0;
 }
 
+NS_OBJECT_ENSURE_REGISTERED (CachedPropagationDelayModel);
+
+TypeId
+CachedPropagationDelayModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CachedPropagationDelayModel")
+    .SetParent<PropagationDelayModel> ()
+    .SetGroupName ("Propagation")
+    .AddConstructor<CachedPropagationDelayModel> ()
+    .AddAttribute ("Model",
+                   "The deterministic propagation delay model whose delay is cached.",
+                   PointerValue (),
+                   MakePointerAccessor (&CachedPropagationDelayModel::SetModel,
+                                        &CachedPropagationDelayModel::GetModel),
+                   MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("Symmetric",
+                   "Whether the delay from a node A to a node B is the delay from B to A.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&CachedPropagationDelayModel::SetSymmetric,
+                                        &CachedPropagationDelayModel::IsSymmetric),
+                   MakeBooleanChecker ())
+    .AddAttribute ("MaxDenseNodes",
+                   "The number of nodes whose pairs are cached in a dense matrix "
+                   "(the pairs of the other nodes are cached in a hash table).",
+                   UintegerValue (512),
+                   MakeUintegerAccessor (&CachedPropagationDelayModel::SetMaxDenseNodes,
+                                         &CachedPropagationDelayModel::GetMaxDenseNodes),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+CachedPropagationDelayModel::CachedPropagationDelayModel ()
+  : m_symmetric (true),
+    m_maxDenseNodes (512)
+{
+}
+CachedPropagationDelayModel::~CachedPropagationDelayModel ()
+{
+}
+void
+CachedPropagationDelayModel::DoDispose (void)
+{
+  m_cache.Clear ();
+  m_model = 0;
+  PropagationDelayModel::DoDispose ();
+}
+Time
+CachedPropagationDelayModel::GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
+{
+  NS_ASSERT_MSG (m_model, "No propagation delay model to cache");
+  return m_cache.Get (a, b, 0, [this, &a, &b] () { return m_model->GetDelay (a, b); });
+}
+void
+CachedPropagationDelayModel::SetModel (Ptr<PropagationDelayModel> model)
+{
+  m_cache.Clear ();
+  m_model = model;
+}
+Ptr<PropagationDelayModel>
+CachedPropagationDelayModel::GetModel (void) const
+{
+  return m_model;
+}
+void
+CachedPropagationDelayModel::SetSymmetric (bool symmetric)
+{
+  m_symmetric = symmetric;
+  m_cache.SetSymmetric (symmetric);
+}
+bool
+CachedPropagationDelayModel::IsSymmetric (void) const
+{
+  return m_symmetric;
+}
+void
+CachedPropagationDelayModel::SetMaxDenseNodes (uint32_t maxDenseNodes)
+{
+  m_maxDenseNodes = maxDenseNodes;
+  m_cache.SetMaxDenseNodes (maxDenseNodes);
+}
+uint32_t
+CachedPropagationDelayModel::GetMaxDenseNodes (void) const
+{
+  return m_maxDenseNodes;
+}
+uint64_t
+CachedPropagationDelayModel::GetHits (void) const
+{
+  return m_cache.GetHits ();
+}
+uint64_t
+CachedPropagationDelayModel::GetMisses (void) const
+{
+  return m_cache.GetMisses ();
+}
+
+int64_t
+CachedPropagationDelayModel::DoAssignStreams (int64_t stream)
+{
+  return m_model ? m_model->AssignStreams (stream) : 0;
+}
+
 
 } // namespace ns3
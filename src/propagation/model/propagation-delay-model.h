@@ -24,6 +24,7 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/random-variable-stream.h"
+#include "propagation-pair-cache.h"
 
 namespace ns3 {
 
@@ -127,6 +128,69 @@ private:
   double m_speed; //!< speed
 };
 
+/**
+ * \ingroup propagation
+ *
+ * \brief Caches the delay computed by another propagation delay model.
+ *
+ * The delay computed by the Model attribute for a pair of nodes is reused
+ * as long as neither node changes its course (see PropagationPairCache).
+ * The wrapped model must be deterministic. If the Symmetric attribute is
+ * true, the delay from a to b is assumed to be the delay from b to a.
+ */
+class CachedPropagationDelayModel : public PropagationDelayModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  CachedPropagationDelayModel ();
+  virtual ~CachedPropagationDelayModel ();
+  virtual Time GetDelay (Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+  /**
+   * \param model the propagation delay model whose delay is cached
+   */
+  void SetModel (Ptr<PropagationDelayModel> model);
+  /**
+   * \return the propagation delay model whose delay is cached
+   */
+  Ptr<PropagationDelayModel> GetModel (void) const;
+  /**
+   * \param symmetric whether the delay from a to b is the delay from b to a
+   */
+  void SetSymmetric (bool symmetric);
+  /**
+   * \return whether the delay from a to b is the delay from b to a
+   */
+  bool IsSymmetric (void) const;
+  /**
+   * \param maxDenseNodes the number of nodes whose pairs are stored in a dense matrix
+   */
+  void SetMaxDenseNodes (uint32_t maxDenseNodes);
+  /**
+   * \return the number of nodes whose pairs are stored in a dense matrix
+   */
+  uint32_t GetMaxDenseNodes (void) const;
+  /**
+   * \return the number of delays found in the cache
+   */
+  uint64_t GetHits (void) const;
+  /**
+   * \return the number of delays computed by the wrapped model
+   */
+  uint64_t GetMisses (void) const;
+protected:
+  virtual void DoDispose (void);
+private:
+  virtual int64_t DoAssignStreams (int64_t stream);
+  Ptr<PropagationDelayModel> m_model;         //!< the wrapped model
+  bool m_symmetric;                           //!< whether the delay is symmetric
+  uint32_t m_maxDenseNodes;                   //!< number of nodes in the dense matrix
+  mutable PropagationPairCache<Time> m_cache; //!< the delays
+};
+
 } // namespace ns3
 
 #endif /* PROPAGATION_DELAY_MODEL_H */
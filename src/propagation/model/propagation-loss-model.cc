@@ -28,6 +28,7 @@
 #include "ns3/double.h"
 #include "ns3/string.h"
 #include "ns3/pointer.h"
+#include "ns3/uinteger.h"
 #include <cmath>
 
 namespace ns3 {
@@ -932,4 +933,129 @@ RangePropagationLossModel::DoAssignStreams (int64_t stream)
 
 // ------------------------------------------------------------------------- //
 
+NS_OBJECT_ENSURE_REGISTERED (CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::CachedPropagationLossModel")
+    .SetParent<PropagationLossModel> ()
+    .SetGroupName ("Propagation")
+    .AddConstructor<CachedPropagationLossModel> ()
+    .AddAttribute ("Model",
+                   "The deterministic propagation loss model whose received power is cached.",
+                   PointerValue (),
+                   MakePointerAccessor (&CachedPropagationLossModel::SetModel,
+                                        &CachedPropagationLossModel::GetModel),
+                   MakePointerChecker<PropagationLossModel> ())
+    .AddAttribute ("Symmetric",
+                   "Whether the loss from a node A to a node B is the loss from B to A.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&CachedPropagationLossModel::SetSymmetric,
+                                        &CachedPropagationLossModel::IsSymmetric),
+                   MakeBooleanChecker ())
+    .AddAttribute ("MaxDenseNodes",
+                   "The number of nodes whose pairs are cached in a dense matrix "
+                   "(the pairs of the other nodes are cached in a hash table).",
+                   UintegerValue (512),
+                   MakeUintegerAccessor (&CachedPropagationLossModel::SetMaxDenseNodes,
+                                         &CachedPropagationLossModel::GetMaxDenseNodes),
+                   MakeUintegerChecker<uint32_t> ())
+  ;
+  return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel ()
+  : m_symmetric (true),
+    m_maxDenseNodes (512)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+CachedPropagationLossModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_cache.Clear ();
+  m_model = 0;
+  PropagationLossModel::DoDispose ();
+}
+
+void
+CachedPropagationLossModel::SetModel (Ptr<PropagationLossModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  m_cache.Clear ();
+  m_model = model;
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetModel (void) const
+{
+  return m_model;
+}
+
+void
+CachedPropagationLossModel::SetSymmetric (bool symmetric)
+{
+  NS_LOG_FUNCTION (this << symmetric);
+  m_symmetric = symmetric;
+  m_cache.SetSymmetric (symmetric);
+}
+
+bool
+CachedPropagationLossModel::IsSymmetric (void) const
+{
+  return m_symmetric;
+}
+
+void
+CachedPropagationLossModel::SetMaxDenseNodes (uint32_t maxDenseNodes)
+{
+  NS_LOG_FUNCTION (this << maxDenseNodes);
+  m_maxDenseNodes = maxDenseNodes;
+  m_cache.SetMaxDenseNodes (maxDenseNodes);
+}
+
+uint32_t
+CachedPropagationLossModel::GetMaxDenseNodes (void) const
+{
+  return m_maxDenseNodes;
+}
+
+uint64_t
+CachedPropagationLossModel::GetHits (void) const
+{
+  return m_cache.GetHits ();
+}
+
+uint64_t
+CachedPropagationLossModel::GetMisses (void) const
+{
+  return m_cache.GetMisses ();
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower (double txPowerDbm,
+                                           Ptr<MobilityModel> a,
+                                           Ptr<MobilityModel> b) const
+{
+  NS_ASSERT_MSG (m_model, "No propagation loss model to cache");
+  return m_cache.Get (a, b, txPowerDbm,
+                      [this, txPowerDbm, &a, &b] () { return m_model->CalcRxPower (txPowerDbm, a, b); });
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams (int64_t stream)
+{
+  return m_model ? m_model->AssignStreams (stream) : 0;
+}
+
+// ------------------------------------------------------------------------- //
+
 } // namespace ns3
@@ -27,6 +27,7 @@
 
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
+#include "propagation-pair-cache.h"
 #include <map>
 
 namespace ns3 {
@@ -856,6 +857,90 @@ private:
   double m_range; //!< Maximum Transmission Range (meters)
 };
 
+/**
+ * \ingroup propagation
+ *
+ * \brief Caches the received power computed by another propagation loss model.
+ *
+ * The received power computed by the Model attribute for a pair of nodes
+ * and a TX power is reused as long as neither node changes its course (see
+ * PropagationPairCache), which saves recomputing the loss between static
+ * nodes for every transmission. The wrapped model (including the models
+ * chained to it) must be deterministic. If the Symmetric attribute is true,
+ * the loss from a to b is assumed to be the loss from b to a.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  CachedPropagationLossModel ();
+  virtual ~CachedPropagationLossModel ();
+
+  /**
+   * \param model the propagation loss model whose received power is cached
+   */
+  void SetModel (Ptr<PropagationLossModel> model);
+  /**
+   * \return the propagation loss model whose received power is cached
+   */
+  Ptr<PropagationLossModel> GetModel (void) const;
+  /**
+   * \param symmetric whether the loss from a to b is the loss from b to a
+   */
+  void SetSymmetric (bool symmetric);
+  /**
+   * \return whether the loss from a to b is the loss from b to a
+   */
+  bool IsSymmetric (void) const;
+  /**
+   * \param maxDenseNodes the number of nodes whose pairs are stored in a dense matrix
+   */
+  void SetMaxDenseNodes (uint32_t maxDenseNodes);
+  /**
+   * \return the number of nodes whose pairs are stored in a dense matrix
+   */
+  uint32_t GetMaxDenseNodes (void) const;
+  /**
+   * \return the number of received powers found in the cache
+   */
+  uint64_t GetHits (void) const;
+  /**
+   * \return the number of received powers computed by the wrapped model
+   */
+  uint64_t GetMisses (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   */
+  CachedPropagationLossModel (const CachedPropagationLossModel&);
+  /**
+   * \brief Copy constructor
+   *
+   * Defined and unimplemented to avoid misuse
+   * \returns
+   */
+  CachedPropagationLossModel& operator= (const CachedPropagationLossModel&);
+  virtual double DoCalcRxPower (double txPowerDbm,
+                                Ptr<MobilityModel> a,
+                                Ptr<MobilityModel> b) const;
+  virtual int64_t DoAssignStreams (int64_t stream);
+
+  Ptr<PropagationLossModel> m_model;              //!< the wrapped model
+  bool m_symmetric;                               //!< whether the loss is symmetric
+  uint32_t m_maxDenseNodes;                       //!< number of nodes in the dense matrix
+  mutable PropagationPairCache<double> m_cache;   //!< the received powers
+};
+
 } // namespace ns3
 
 #endif /* PROPAGATION_LOSS_MODEL_H */
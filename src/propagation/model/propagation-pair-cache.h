@@ -0,0 +1,294 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PROPAGATION_PAIR_CACHE_H
+#define PROPAGATION_PAIR_CACHE_H
+
+#include <vector>
+#include <unordered_map>
+#include "ns3/mobility-model.h"
+#include "ns3/callback.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup propagation
+ * \brief Cache of values computed for pairs of mobility models.
+ *
+ * Each value is stored along with the input it was computed for (e.g., the
+ * TX power) and is returned as long as neither mobility model changes its
+ * course and the same input is used. Mobility models are numbered in the
+ * order they are first seen; the values of the pairs of the first
+ * MaxDenseNodes mobility models are stored in a dense (triangular, if
+ * the values are symmetric) matrix, the others in a hash table. Values are
+ * never cached for a mobility model moving at a non-zero velocity, since
+ * its position changes without notification.
+ *
+ * \tparam T the type of the cached values
+ */
+template <typename T>
+class PropagationPairCache
+{
+public:
+  PropagationPairCache ();
+  ~PropagationPairCache ();
+
+  /**
+   * \param symmetric whether the value of (a, b) is also the value of (b, a)
+   */
+  void SetSymmetric (bool symmetric);
+  /**
+   * \param maxDenseNodes the number of mobility models whose pairs are
+   *        stored in a dense matrix
+   */
+  void SetMaxDenseNodes (uint32_t maxDenseNodes);
+  /**
+   * Get the value of a pair of mobility models, computing it if it is not
+   * in the cache.
+   *
+   * \tparam F the type of the function computing the value
+   * \param a the first mobility model
+   * \param b the second mobility model
+   * \param input the input of the computation
+   * \param compute function computing the value
+   * \return the value of the pair
+   */
+  template <typename F>
+  T Get (Ptr<MobilityModel> a, Ptr<MobilityModel> b, double input, F compute);
+  /**
+   * Remove all the values from the cache and stop tracking mobility models.
+   */
+  void Clear (void);
+  /**
+   * \return the number of values found in the cache
+   */
+  uint64_t GetHits (void) const;
+  /**
+   * \return the number of values that had to be computed
+   */
+  uint64_t GetMisses (void) const;
+
+private:
+  /// A cached value
+  struct Entry
+  {
+    uint32_t epochs[2]; //!< course epochs of the two mobility models when the value was computed (0 if empty)
+    double input;       //!< input of the computation
+    T value;            //!< the value
+  };
+
+  /**
+   * \param mobility a mobility model
+   * \return the identifier of the mobility model, which is assigned if the
+   *         model was not seen before
+   */
+  uint32_t GetId (Ptr<MobilityModel> mobility);
+  /**
+   * \param i the identifier of the first mobility model
+   * \param j the identifier of the second mobility model (different from i)
+   * \return the entry of the pair
+   */
+  Entry & GetEntry (uint32_t i, uint32_t j);
+  /**
+   * Invalidate the values involving a mobility model whose course changed.
+   *
+   * \param mobility the mobility model
+   */
+  void NotifyCourseChange (Ptr<const MobilityModel> mobility);
+
+  bool m_symmetric;                                            //!< whether values are symmetric
+  uint32_t m_maxDenseNodes;                                    //!< number of mobility models in the dense matrix
+  std::vector<Ptr<MobilityModel> > m_mobilities;               //!< mobility models indexed by identifier
+  std::vector<uint32_t> m_epochs;                              //!< course epoch of each mobility model
+  std::unordered_map<const MobilityModel *, uint32_t> m_ids;   //!< identifier of each mobility model
+  std::vector<Entry> m_lower;                                  //!< dense entries of (i, j) with i > j
+  std::vector<Entry> m_upper;                                  //!< dense entries of (j, i) with i > j, if not symmetric
+  std::unordered_map<uint64_t, Entry> m_sparse;                //!< entries of the other pairs
+  uint64_t m_hits;                                             //!< number of hits
+  uint64_t m_misses;                                           //!< number of misses
+};
+
+/*************************************************************
+ *  Implementation of the templates declared above.
+ *************************************************************/
+
+template <typename T>
+PropagationPairCache<T>::PropagationPairCache ()
+  : m_symmetric (true),
+    m_maxDenseNodes (512),
+    m_hits (0),
+    m_misses (0)
+{
+}
+
+template <typename T>
+PropagationPairCache<T>::~PropagationPairCache ()
+{
+  Clear ();
+}
+
+template <typename T>
+void
+PropagationPairCache<T>::SetSymmetric (bool symmetric)
+{
+  Clear ();
+  m_symmetric = symmetric;
+}
+
+template <typename T>
+void
+PropagationPairCache<T>::SetMaxDenseNodes (uint32_t maxDenseNodes)
+{
+  Clear ();
+  m_maxDenseNodes = maxDenseNodes;
+}
+
+template <typename T>
+template <typename F>
+T
+PropagationPairCache<T>::Get (Ptr<MobilityModel> a, Ptr<MobilityModel> b, double input, F compute)
+{
+  if (a == b)
+    {
+      m_misses++;
+      return compute ();
+    }
+  Vector velocityA = a->GetVelocity ();
+  Vector velocityB = b->GetVelocity ();
+  if (velocityA.x != 0 || velocityA.y != 0 || velocityA.z != 0
+      || velocityB.x != 0 || velocityB.y != 0 || velocityB.z != 0)
+    {
+      m_misses++;
+      return compute ();
+    }
+  uint32_t i = GetId (a);
+  uint32_t j = GetId (b);
+  Entry &entry = GetEntry (i, j);
+  // the epochs are stored in the order of the identifiers so that the
+  // entry of a symmetric pair does not depend on the order of the models
+  uint32_t epochI = m_epochs[i];
+  uint32_t epochJ = m_epochs[j];
+  bool swap = m_symmetric && i < j;
+  uint32_t epoch0 = swap ? epochJ : epochI;
+  uint32_t epoch1 = swap ? epochI : epochJ;
+  if (entry.epochs[0] == epoch0 && entry.epochs[1] == epoch1 && entry.input == input)
+    {
+      m_hits++;
+      return entry.value;
+    }
+  m_misses++;
+  T value = compute ();
+  // the entry is looked up again since computing the value may have added
+  // entries to the cache (e.g., if the models use the same cache)
+  Entry &newEntry = GetEntry (i, j);
+  newEntry.epochs[0] = epoch0;
+  newEntry.epochs[1] = epoch1;
+  newEntry.input = input;
+  newEntry.value = value;
+  return value;
+}
+
+template <typename T>
+void
+PropagationPairCache<T>::Clear (void)
+{
+  for (auto & mobility : m_mobilities)
+    {
+      mobility->TraceDisconnectWithoutContext ("CourseChange",
+                                               MakeCallback (&PropagationPairCache<T>::NotifyCourseChange, this));
+    }
+  m_mobilities.clear ();
+  m_epochs.clear ();
+  m_ids.clear ();
+  m_lower.clear ();
+  m_upper.clear ();
+  m_sparse.clear ();
+}
+
+template <typename T>
+uint64_t
+PropagationPairCache<T>::GetHits (void) const
+{
+  return m_hits;
+}
+
+template <typename T>
+uint64_t
+PropagationPairCache<T>::GetMisses (void) const
+{
+  return m_misses;
+}
+
+template <typename T>
+uint32_t
+PropagationPairCache<T>::GetId (Ptr<MobilityModel> mobility)
+{
+  auto it = m_ids.find (PeekPointer (mobility));
+  if (it != m_ids.end ())
+    {
+      return it->second;
+    }
+  uint32_t id = m_mobilities.size ();
+  m_ids.insert ({PeekPointer (mobility), id});
+  m_mobilities.push_back (mobility);
+  m_epochs.push_back (1);
+  mobility->TraceConnectWithoutContext ("CourseChange",
+                                        MakeCallback (&PropagationPairCache<T>::NotifyCourseChange, this));
+  if (id < m_maxDenseNodes)
+    {
+      // add the row of the new mobility model to the dense matrix
+      std::size_t size = static_cast<std::size_t> (id + 1) * id / 2;
+      m_lower.resize (size, Entry {{0, 0}, 0, T ()});
+      if (!m_symmetric)
+        {
+          m_upper.resize (size, Entry {{0, 0}, 0, T ()});
+        }
+    }
+  return id;
+}
+
+template <typename T>
+typename PropagationPairCache<T>::Entry &
+PropagationPairCache<T>::GetEntry (uint32_t i, uint32_t j)
+{
+  bool upper = (i < j);
+  uint32_t row = upper ? j : i;
+  uint32_t column = upper ? i : j;
+  if (row < m_maxDenseNodes)
+    {
+      std::size_t index = static_cast<std::size_t> (row) * (row - 1) / 2 + column;
+      return (upper && !m_symmetric) ? m_upper[index] : m_lower[index];
+    }
+  uint64_t key = m_symmetric ? ((static_cast<uint64_t> (row) << 32) | column)
+                             : ((static_cast<uint64_t> (i) << 32) | j);
+  return m_sparse.insert ({key, Entry {{0, 0}, 0, T ()}}).first->second;
+}
+
+template <typename T>
+void
+PropagationPairCache<T>::NotifyCourseChange (Ptr<const MobilityModel> mobility)
+{
+  auto it = m_ids.find (PeekPointer (mobility));
+  if (it != m_ids.end ())
+    {
+      // invalidates all the entries involving this mobility model
+      m_epochs[it->second]++;
+    }
+}
+
+} // namespace ns3
+
+#endif /* PROPAGATION_PAIR_CACHE_H */
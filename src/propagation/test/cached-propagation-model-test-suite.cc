@@ -0,0 +1,198 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/pointer.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("CachedPropagationModelTest");
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Check that CachedPropagationLossModel and CachedPropagationDelayModel
+ * return the same values as the models they wrap, for static and moving
+ * nodes, and that they reuse the values of static nodes.
+ */
+class CachedPropagationModelTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param symmetric whether the cache is symmetric
+   * \param maxDenseNodes the number of nodes in the dense matrix of the cache
+   */
+  CachedPropagationModelTestCase (bool symmetric, uint32_t maxDenseNodes);
+  virtual ~CachedPropagationModelTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Compare the cached and direct values for all pairs of nodes
+   *
+   * \param txPowerDbm the TX power (dBm)
+   */
+  void CheckAllPairs (double txPowerDbm);
+  /**
+   * Move some of the static nodes
+   */
+  void MoveNodes (void);
+
+  bool m_symmetric;                                 //!< whether the cache is symmetric
+  uint32_t m_maxDenseNodes;                         //!< number of nodes in the dense matrix
+  std::vector<Ptr<MobilityModel> > m_mobilities;   //!< mobility models of the nodes
+  Ptr<PropagationLossModel> m_loss;                 //!< the wrapped loss model
+  Ptr<CachedPropagationLossModel> m_cachedLoss;     //!< the cached loss model
+  Ptr<PropagationDelayModel> m_delay;               //!< the wrapped delay model
+  Ptr<CachedPropagationDelayModel> m_cachedDelay;   //!< the cached delay model
+  Ptr<UniformRandomVariable> m_random;              //!< random variable
+};
+
+CachedPropagationModelTestCase::CachedPropagationModelTestCase (bool symmetric, uint32_t maxDenseNodes)
+  : TestCase ("Check cached propagation models (symmetric=" + std::to_string (symmetric)
+              + ", max dense nodes=" + std::to_string (maxDenseNodes) + ")"),
+    m_symmetric (symmetric),
+    m_maxDenseNodes (maxDenseNodes)
+{
+}
+
+CachedPropagationModelTestCase::~CachedPropagationModelTestCase ()
+{
+}
+
+void
+CachedPropagationModelTestCase::CheckAllPairs (double txPowerDbm)
+{
+  for (auto & a : m_mobilities)
+    {
+      for (auto & b : m_mobilities)
+        {
+          NS_TEST_EXPECT_MSG_EQ (m_cachedLoss->CalcRxPower (txPowerDbm, a, b), m_loss->CalcRxPower (txPowerDbm, a, b),
+                                 "Cached received power differs from the one of the wrapped model");
+          NS_TEST_EXPECT_MSG_EQ (m_cachedDelay->GetDelay (a, b), m_delay->GetDelay (a, b),
+                                 "Cached delay differs from the one of the wrapped model");
+        }
+    }
+}
+
+void
+CachedPropagationModelTestCase::MoveNodes (void)
+{
+  for (std::size_t i = 1; i < m_mobilities.size (); i += 4)
+    {
+      m_mobilities[i]->SetPosition (Vector (m_random->GetValue (0, 500), m_random->GetValue (0, 500), 0));
+    }
+}
+
+void
+CachedPropagationModelTestCase::DoRun (void)
+{
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (1);
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      Ptr<MobilityModel> mobility;
+      if (i % 7 == 0)
+        {
+          mobility = CreateObject<ConstantVelocityMobilityModel> ();
+        }
+      else
+        {
+          mobility = CreateObject<ConstantPositionMobilityModel> ();
+        }
+      mobility->SetPosition (Vector (m_random->GetValue (0, 500), m_random->GetValue (0, 500), 0));
+      if (i % 7 == 0)
+        {
+          // the velocity must be set after the position, which resets it
+          DynamicCast<ConstantVelocityMobilityModel> (mobility)->SetVelocity (Vector (10, 5, 0));
+        }
+      m_mobilities.push_back (mobility);
+    }
+
+  m_loss = CreateObject<LogDistancePropagationLossModel> ();
+  m_loss->SetNext (CreateObject<FriisPropagationLossModel> ());
+  m_cachedLoss = CreateObjectWithAttributes<CachedPropagationLossModel> ("Model", PointerValue (m_loss),
+                                                                          "Symmetric", BooleanValue (m_symmetric),
+                                                                          "MaxDenseNodes", UintegerValue (m_maxDenseNodes));
+  m_delay = CreateObject<ConstantSpeedPropagationDelayModel> ();
+  m_cachedDelay = CreateObjectWithAttributes<CachedPropagationDelayModel> ("Model", PointerValue (m_delay),
+                                                                            "Symmetric", BooleanValue (m_symmetric),
+                                                                            "MaxDenseNodes", UintegerValue (m_maxDenseNodes));
+
+  Simulator::Schedule (Seconds (1), &CachedPropagationModelTestCase::CheckAllPairs, this, 16);
+  Simulator::Schedule (Seconds (2), &CachedPropagationModelTestCase::CheckAllPairs, this, 16);
+  Simulator::Schedule (Seconds (3), &CachedPropagationModelTestCase::MoveNodes, this);
+  Simulator::Schedule (Seconds (4), &CachedPropagationModelTestCase::CheckAllPairs, this, 20);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // The values of the pairs of distinct static nodes are computed at the
+  // first check and reused at the second check. The third check uses another
+  // TX power, hence the received powers are computed again, whereas the delays
+  // of the nodes that did not move are reused. If the cache is symmetric, the
+  // value computed for (a, b) is also reused for (b, a).
+  uint64_t nStatic = 17;
+  uint64_t nUnmoved = 12;
+  uint64_t reverseHits = m_symmetric ? nStatic * (nStatic - 1) / 2 : 0;
+  uint64_t allStaticHits = nStatic * (nStatic - 1);
+  uint64_t unmovedHits = nUnmoved * (nUnmoved - 1);
+  uint64_t movedReverseHits = m_symmetric ? reverseHits - unmovedHits / 2 : 0;
+  uint64_t calls = 3 * 20 * 20;
+  NS_TEST_EXPECT_MSG_EQ (m_cachedLoss->GetHits () + m_cachedLoss->GetMisses (), calls, "Unexpected number of loss computations");
+  NS_TEST_EXPECT_MSG_EQ (m_cachedLoss->GetHits (), reverseHits + allStaticHits + reverseHits,
+                         "Unexpected number of losses found in the cache");
+  NS_TEST_EXPECT_MSG_EQ (m_cachedDelay->GetHits () + m_cachedDelay->GetMisses (), calls, "Unexpected number of delay computations");
+  NS_TEST_EXPECT_MSG_EQ (m_cachedDelay->GetHits (), reverseHits + allStaticHits + unmovedHits + movedReverseHits,
+                         "Unexpected number of delays found in the cache");
+
+  m_cachedLoss->Dispose ();
+  m_cachedDelay->Dispose ();
+  m_mobilities.clear ();
+}
+
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief Cached propagation models Test Suite
+ */
+class CachedPropagationModelTestSuite : public TestSuite
+{
+public:
+  CachedPropagationModelTestSuite ();
+};
+
+CachedPropagationModelTestSuite::CachedPropagationModelTestSuite ()
+  : TestSuite ("cached-propagation-models", UNIT)
+{
+  AddTestCase (new CachedPropagationModelTestCase (true, 512), TestCase::QUICK);
+  AddTestCase (new CachedPropagationModelTestCase (false, 512), TestCase::QUICK);
+  // pairs involving the last nodes are cached in the hash table
+  AddTestCase (new CachedPropagationModelTestCase (true, 8), TestCase::QUICK);
+  AddTestCase (new CachedPropagationModelTestCase (false, 8), TestCase::QUICK);
+}
+
+static CachedPropagationModelTestSuite g_cachedPropagationModelTestSuite; ///< the test suite
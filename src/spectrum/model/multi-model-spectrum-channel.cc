@@ -20,6 +20,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <utility>
 #include <ns3/object.h>
 #include <ns3/simulator.h>
@@ -29,6 +30,7 @@
 #include <ns3/net-device.h>
 #include <ns3/node.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
 #include <ns3/mobility-model.h>
 #include <ns3/spectrum-phy.h>
 #include <ns3/spectrum-converter.h>
@@ -79,7 +81,9 @@ RxSpectrumModelInfo::RxSpectrumModelInfo (Ptr<const SpectrumModel> rxSpectrumMod
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel ()
-  : m_numDevices {0}
+  : m_numDevices {0},
+    m_sharedPsd {true},
+    m_maxRange {std::numeric_limits<double>::infinity ()}
 {
   NS_LOG_FUNCTION (this);
 }
@@ -100,7 +104,26 @@ MultiModelSpectrumChannel::GetTypeId (void)
     .SetParent<SpectrumChannel> ()
     .SetGroupName ("Spectrum")
     .AddConstructor<MultiModelSpectrumChannel> ()
-
+    .AddAttribute ("SharedPsd",
+                   "If true, the receivers that support it (see SpectrumPhy::IsSharedPsdSupported) "
+                   "share a single copy of the transmitted PSD (converted to their SpectrumModel), "
+                   "along with the gain of the propagation channel, instead of each receiving "
+                   "a scaled copy of the PSD. This is not done if a SpectrumPropagationLossModel "
+                   "is used, since its gain depends on the frequency.",
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&MultiModelSpectrumChannel::m_sharedPsd),
+                   MakeBooleanChecker ())
+    .AddAttribute ("MaxRange",
+                   "The maximum distance (m) between the transmitter and the receivers "
+                   "of a signal. If set, the receivers are looked up in a spatial index "
+                   "and the signal is not delivered to the receivers that are farther "
+                   "away (receivers without mobility model always get the signal). "
+                   "The results are unchanged provided that the range is large enough "
+                   "for the signals to be negligible beyond it and that the propagation "
+                   "models are deterministic.",
+                   DoubleValue (std::numeric_limits<double>::infinity ()),
+                   MakeDoubleAccessor (&MultiModelSpectrumChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0, std::numeric_limits<double>::infinity ()))
   ;
   return tid;
 }
@@ -128,6 +151,7 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
       if (phyIt != rxInfoIterator->second.m_rxPhys.end ())
         {
           rxInfoIterator->second.m_rxPhys.erase (phyIt);
+          rxInfoIterator->second.m_rxPhyIndex = 0;
           --m_numDevices;
           break; // there should be at most one entry
         }       
@@ -168,6 +192,7 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
     {
       // spectrum model is already known, just add the device to the corresponding list
       rxInfoIterator->second.m_rxPhys.push_back (phy);
+      rxInfoIterator->second.m_rxPhyIndex = 0;
     }
 }
 
@@ -235,7 +260,7 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   NS_LOG_LOGIC ("converter map size: " << txInfoIteratorerator->second.m_spectrumConverterMap.size ());
   NS_LOG_LOGIC ("converter map first element: " << txInfoIteratorerator->second.m_spectrumConverterMap.begin ()->first);
 
-  for (RxSpectrumModelInfoMap_t::const_iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
+  for (RxSpectrumModelInfoMap_t::iterator rxInfoIterator = m_rxSpectrumModelInfoMap.begin ();
        rxInfoIterator != m_rxSpectrumModelInfoMap.end ();
        ++rxInfoIterator)
     {
@@ -260,18 +285,73 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
           convertedTxPowerSpectrum = rxConverterIterator->second.Convert (txParams->psd);
         }
 
-      for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin ();
-           rxPhyIterator != rxInfoIterator->second.m_rxPhys.end ();
-           ++rxPhyIterator)
+      // signal parameters sharing the converted PSD, from which the signal
+      // parameters of the receivers supporting shared PSDs are copied
+      // without copying the PSD
+      Ptr<SpectrumSignalParameters> sharedRxParams;
+
+      // If a maximum range is set, only look at the receivers that may be in
+      // range of the transmitter, in the order they were added to the channel
+      std::vector<Ptr<SpectrumPhy> > &rxPhys = rxInfoIterator->second.m_rxPhys;
+      bool checkRange = txMobility && m_maxRange != std::numeric_limits<double>::infinity ();
+      Vector txPosition;
+      if (checkRange)
+        {
+          Ptr<GridSpatialIndex> &rxPhyIndex = rxInfoIterator->second.m_rxPhyIndex;
+          if (!rxPhyIndex || rxPhyIndex->GetCellSize () != m_maxRange)
+            {
+              rxPhyIndex = Create<GridSpatialIndex> (m_maxRange);
+              for (const auto & rxPhy : rxPhys)
+                {
+                  rxPhyIndex->Add (rxPhy->GetMobility ());
+                }
+            }
+          txPosition = txMobility->GetPosition ();
+          rxPhyIndex->GetCandidates (txPosition, m_maxRange, m_rxPhyCandidates);
+        }
+      else
+        {
+          m_rxPhyCandidates.resize (rxPhys.size ());
+          for (uint32_t i = 0; i < rxPhys.size (); i++)
+            {
+              m_rxPhyCandidates[i] = i;
+            }
+        }
+
+      for (uint32_t rxPhyId : m_rxPhyCandidates)
         {
+          auto rxPhyIterator = rxPhys.begin () + rxPhyId;
+          if (checkRange && (*rxPhyIterator)->GetMobility ()
+              && CalculateDistance (txPosition, (*rxPhyIterator)->GetMobility ()->GetPosition ()) > m_maxRange)
+            {
+              NS_LOG_LOGIC ("receiver " << *rxPhyIterator << " out of range");
+              continue;
+            }
           NS_ASSERT_MSG ((*rxPhyIterator)->GetRxSpectrumModel ()->GetUid () == rxSpectrumModelUid,
                          "SpectrumModel change was not notified to MultiModelSpectrumChannel (i.e., AddRx should be called again after model is changed)");
 
           if ((*rxPhyIterator) != txParams->txPhy)
             {
-              NS_LOG_LOGIC ("copying signal parameters " << txParams);
-              Ptr<SpectrumSignalParameters> rxParams = txParams->Copy ();
-              rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
+              Ptr<SpectrumSignalParameters> rxParams;
+              bool sharedPsd = m_sharedPsd && !m_spectrumPropagationLoss && (*rxPhyIterator)->IsSharedPsdSupported ();
+              if (sharedPsd)
+                {
+                  if (!sharedRxParams)
+                    {
+                      sharedRxParams = txParams->Copy ();
+                      sharedRxParams->psd = 0;
+                      sharedRxParams->sharedPsd = convertedTxPowerSpectrum;
+                      sharedRxParams->sharedPsdGain = 1.0;
+                    }
+                  NS_LOG_LOGIC ("copying signal parameters " << txParams << " with shared PSD");
+                  rxParams = sharedRxParams->Copy ();
+                }
+              else
+                {
+                  NS_LOG_LOGIC ("copying signal parameters " << txParams);
+                  rxParams = txParams->Copy ();
+                  rxParams->psd = Copy<SpectrumValue> (convertedTxPowerSpectrum);
+                }
               Time delay = MicroSeconds (0);
 
               Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility ();
@@ -314,7 +394,14 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                       continue;
                     }
                   double pathGainLinear = std::pow (10.0, (-pathLossDb) / 10.0);
-                  *(rxParams->psd) *= pathGainLinear;              
+                  if (sharedPsd)
+                    {
+                      rxParams->sharedPsdGain = pathGainLinear;
+                    }
+                  else
+                    {
+                      *(rxParams->psd) *= pathGainLinear;
+                    }
 
                   if (m_spectrumPropagationLoss)
                     {
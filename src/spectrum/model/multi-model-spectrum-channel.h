@@ -27,6 +27,7 @@
 #include <ns3/spectrum-channel.h>
 #include <ns3/spectrum-propagation-loss-model.h>
 #include <ns3/propagation-delay-model.h>
+#include <ns3/grid-spatial-index.h>
 #include <map>
 #include <set>
 
@@ -81,6 +82,7 @@ public:
 
   Ptr<const SpectrumModel> m_rxSpectrumModel;  //!< Rx Spectrum model.
   std::vector<Ptr<SpectrumPhy> > m_rxPhys;     //!< Container of the Rx Spectrum phy objects.
+  Ptr<GridSpatialIndex> m_rxPhyIndex;          //!< Spatial index of the Rx Spectrum phy objects (built on demand).
 };
 
 /**
@@ -169,6 +171,21 @@ private:
    */
   std::size_t m_numDevices;
 
+  /**
+   * Whether receivers supporting it share the transmitted PSD
+   */
+  bool m_sharedPsd;
+
+  /**
+   * Maximum distance between the transmitter and the receivers of a signal
+   */
+  double m_maxRange;
+
+  /**
+   * Indices of the receivers that may be in range of the transmitter
+   */
+  std::vector<uint32_t> m_rxPhyCandidates;
+
 };
 
 
@@ -112,6 +112,15 @@ public:
    */
   virtual void StartRx (Ptr<SpectrumSignalParameters> params) = 0;
 
+  /**
+   * Whether this SpectrumPhy accepts signals whose received PSD is carried
+   * as a shared PSD and a gain (see SpectrumSignalParameters::sharedPsd)
+   * rather than as a private PSD. The default implementation returns false.
+   *
+   * @return true if shared PSDs are supported, false otherwise
+   */
+  virtual bool IsSharedPsdSupported (void) const;
+
 private:
   /**
    * \brief Copy constructor
@@ -31,6 +31,7 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("SpectrumSignalParameters");
 
 SpectrumSignalParameters::SpectrumSignalParameters ()
+  : sharedPsdGain (1.0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -43,7 +44,12 @@ SpectrumSignalParameters::~SpectrumSignalParameters ()
 SpectrumSignalParameters::SpectrumSignalParameters (const SpectrumSignalParameters& p)
 {
   NS_LOG_FUNCTION (this << &p);
-  psd = p.psd->Copy ();
+  if (p.psd)
+    {
+      psd = p.psd->Copy ();
+    }
+  sharedPsd = p.sharedPsd;
+  sharedPsdGain = p.sharedPsdGain;
   duration = p.duration;
   txPhy = p.txPhy;
   txAntenna = p.txAntenna;
@@ -56,6 +62,20 @@ SpectrumSignalParameters::Copy ()
   return Create<SpectrumSignalParameters> (*this);
 }
 
+Ptr<SpectrumValue>
+SpectrumSignalParameters::GetPsd (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!psd && sharedPsd)
+    {
+      psd = sharedPsd->Copy ();
+      *psd *= sharedPsdGain;
+      sharedPsd = 0;
+      sharedPsdGain = 1.0;
+    }
+  return psd;
+}
+
 
 
 } // namespace ns3
@@ -93,6 +93,32 @@ struct SpectrumSignalParameters : public SimpleRefCount<SpectrumSignalParameters
    */
   Ptr <SpectrumValue> psd;
 
+  /**
+   * The Power Spectral Density of the waveform before the gain of the
+   * propagation channel, shared by all the receivers of the transmission.
+   * This is used in place of psd (which is then null) when the receiver
+   * accepts shared PSDs (see SpectrumPhy::IsSharedPsdSupported), in which case
+   * the received PSD is sharedPsd scaled by sharedPsdGain. The shared PSD
+   * must not be modified: GetPsd () returns a private copy of it.
+   *
+   * \note when SpectrumSignalParameters is copied, only the pointer to the shared PSD is copied.
+   */
+  Ptr<const SpectrumValue> sharedPsd;
+
+  /**
+   * The linear gain to be applied to sharedPsd to get the received PSD.
+   */
+  double sharedPsdGain;
+
+  /**
+   * Get the Power Spectral Density of the waveform. If the signal carries a
+   * shared PSD, it is copied, scaled by sharedPsdGain and stored in psd
+   * (copy-on-write) so that the returned PSD can be modified.
+   *
+   * \return the Power Spectral Density of the waveform
+   */
+  Ptr<SpectrumValue> GetPsd (void);
+
   /**
    * The duration of the packet transmission. It is
    * assumed that the Power Spectral Density remains constant for the
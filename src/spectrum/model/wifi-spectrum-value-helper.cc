@@ -492,6 +492,21 @@ WifiSpectrumValueHelper::CreateRfFilter (uint32_t centerFrequency, uint16_t tota
   return c;
 }
 
+double
+WifiSpectrumValueHelper::GetBandPowerW (Ptr<const SpectrumValue> psd, const WifiSpectrumBand &band, double gain)
+{
+  NS_ASSERT_MSG (band.second < psd->GetSpectrumModel ()->GetNumBands (), "Band is out of the spectrum model");
+  double powerW = 0;
+  Values::const_iterator vit = psd->ConstValuesBegin () + band.first;
+  Bands::const_iterator bit = psd->ConstBandsBegin () + band.first;
+  for (size_t i = band.first; i <= band.second; i++, vit++, bit++)
+    {
+      // the gain is applied to each value, like a scaling of the PSD would do
+      powerW += ((*vit) * gain) * (bit->fh - bit->fl);
+    }
+  return powerW;
+}
+
 void
 WifiSpectrumValueHelper::CreateSpectrumMaskForOfdm (Ptr<SpectrumValue> c, std::vector <WifiSpectrumBand> allocatedSubBands, WifiSpectrumBand maskBand,
                                                     double txPowerPerBandW, uint32_t nGuardBands, uint32_t innerSlopeWidth,
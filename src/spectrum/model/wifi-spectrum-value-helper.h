@@ -178,6 +178,20 @@ public:
    * to an received power spectral density
    */
   static Ptr<SpectrumValue> CreateRfFilter (uint32_t centerFrequency, uint16_t totalChannelWidth, uint32_t bandBandwidth, uint16_t guardBandwidth, WifiSpectrumBand band);
+  /**
+   * Calculate the power of the specified band, i.e. the integral of the
+   * received power spectral density filtered by the RF filter of that band.
+   * This yields the same result as applying the filter returned by
+   * CreateRfFilter, but sums the PSD values of the band directly, with no
+   * allocation.
+   *
+   * \param psd received power spectral density (W/Hz)
+   * \param band the pair of start and stop indexes that defines the band
+   * \param gain the linear gain applied to each value of the PSD
+   *
+   * \return band power in W
+   */
+  static double GetBandPowerW (Ptr<const SpectrumValue> psd, const WifiSpectrumBand &band, double gain = 1.0);
 
   /**
    * Create a transmit power spectral density corresponding to OFDM
@@ -1085,6 +1085,7 @@ int main (int argc, char *argv[])
   double distance = 0.001;                ///< The distance in meters between the AP and the STAs
   double apTxPower = 16;                  ///< The transmit power of the AP in dBm (if infrastructure only)
   double staTxPower = 16;                 ///< The transmit power of each STA in dBm (or all STAs if adhoc)
+  bool disableMetadata = false;           ///< Flag to disable the packet metadata
 
   // Disable fragmentation and RTS/CTS
   Config::SetDefault ("ns3::WifiRemoteStationManager::FragmentationThreshold", StringValue ("22000"));
@@ -1121,8 +1122,14 @@ int main (int argc, char *argv[])
   cmd.AddValue ("apTxPower", "Set the transmit power of the AP in dBm (if infrastructure only)", apTxPower);
   cmd.AddValue ("staTxPower", "Set the transmit power of each STA in dBm (or all STAs if adhoc)", staTxPower);
   cmd.AddValue ("pktInterval", "Set the socket packet interval in microseconds", pktInterval);
+  cmd.AddValue ("disableMetadata", "Disable the packet metadata (see Packet::DisableMetadata)", disableMetadata);
   cmd.Parse (argc, argv);
 
+  if (disableMetadata)
+    {
+      Packet::DisableMetadata ();
+    }
+
   if (tracing)
     {
       cwTraceFile.open ("wifi-bianchi-cw-trace.out");
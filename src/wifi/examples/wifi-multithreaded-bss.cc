@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program compares a sequential simulation of several Wi-Fi basic
+// service sets with multithreaded simulations of the same network.
+//
+// --nBss independent (adhoc) basic service sets are placed on a line,
+// --distance meters apart, and share a single YansWifiChannel. Each BSS
+// has --nStations 802.11a stations placed on a circle of radius --radius
+// around its first station, to which they send saturated traffic. The
+// simulation, lasting --simTime seconds, is run sequentially, then with
+// each number of threads of --threads: the basic service sets are
+// assigned to the partitions in a round-robin fashion, and the lookahead
+// is the smallest propagation delay between two nodes of different
+// partitions. The wall-clock time, the number of executed events and the
+// number of received packets are reported.
+//
+
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/wifi-partition-helper.h"
+
+using namespace ns3;
+
+std::atomic<uint64_t> g_rxPackets (0); ///< number of packets received by the applications
+uint64_t g_events = 0; ///< number of events executed during the simulation
+
+/**
+ * Application RX trace sink
+ *
+ * \param p the received packet
+ * \param from the sender address
+ */
+void
+AppRx (Ptr<const Packet> p, const Address &from)
+{
+  g_rxPackets++;
+}
+
+/**
+ * Run the simulation
+ *
+ * \param nThreads the number of threads, 0 for a sequential simulation
+ * \param nBss the number of basic service sets
+ * \param nStations the number of stations per basic service set
+ * \param simTime the simulation time
+ * \param distance the distance between basic service sets
+ * \param radius the radius of the circle on which the stations of a BSS are placed
+ * \return the wall-clock duration of the simulation in seconds
+ */
+double
+Run (uint32_t nThreads, uint32_t nBss, uint32_t nStations, Time simTime, double distance, double radius)
+{
+  g_rxPackets = 0;
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+  if (nThreads > 0)
+    {
+      Simulator::SetImplementation (CreateObject<MultithreadedSimulatorImpl> ());
+    }
+  else
+    {
+      Simulator::SetImplementation (CreateObject<DefaultSimulatorImpl> ());
+    }
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy;
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate24Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  PacketSocketHelper packetSocket;
+  WifiPartitionHelper partition;
+
+  for (uint32_t b = 0; b < nBss; b++)
+    {
+      NodeContainer nodes;
+      nodes.Create (nStations);
+      NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+      wifi.AssignStreams (devices, 1 + b * nStations * 100);
+
+      Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+      positionAlloc->Add (Vector (b * distance, 0, 0));
+      for (uint32_t i = 1; i < nStations; i++)
+        {
+          double angle = 2 * M_PI * i / nStations;
+          positionAlloc->Add (Vector (b * distance + radius * std::cos (angle), radius * std::sin (angle), 0));
+        }
+      mobility.SetPositionAllocator (positionAlloc);
+      mobility.Install (nodes);
+      packetSocket.Install (nodes);
+
+      Ptr<PacketSocketServer> server = CreateObject<PacketSocketServer> ();
+      PacketSocketAddress local;
+      local.SetSingleDevice (devices.Get (0)->GetIfIndex ());
+      local.SetProtocol (1);
+      server->SetLocal (local);
+      nodes.Get (0)->AddApplication (server);
+
+      for (uint32_t i = 1; i < nStations; i++)
+        {
+          PacketSocketAddress socket;
+          socket.SetSingleDevice (devices.Get (i)->GetIfIndex ());
+          socket.SetPhysicalAddress (devices.Get (0)->GetAddress ());
+          socket.SetProtocol (1);
+
+          Ptr<PacketSocketClient> client = CreateObject<PacketSocketClient> ();
+          client->SetAttribute ("PacketSize", UintegerValue (1000));
+          client->SetAttribute ("MaxPackets", UintegerValue (0));
+          client->SetAttribute ("Interval", TimeValue (MicroSeconds (500)));
+          client->SetRemote (socket);
+          nodes.Get (i)->AddApplication (client);
+          client->SetStartTime (MilliSeconds (10 + i));
+        }
+
+      if (nThreads > 0)
+        {
+          partition.SetPartition (nodes, b % nThreads);
+        }
+    }
+
+  if (nThreads > 0)
+    {
+      partition.Install ();
+    }
+
+  Config::ConnectWithoutContext ("/NodeList/*/ApplicationList/*/$ns3::PacketSocketServer/Rx",
+                                 MakeCallback (&AppRx));
+
+  Simulator::Stop (simTime);
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  double elapsed = clock.End () / 1000.0;
+  g_events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+  return elapsed;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nBss = 8;
+  uint32_t nStations = 5;
+  double simTime = 2;
+  double distance = 100;
+  double radius = 10;
+  std::string threads = "1,2,4";
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("nBss", "Number of basic service sets", nBss);
+  cmd.AddValue ("nStations", "Number of stations per basic service set", nStations);
+  cmd.AddValue ("simTime", "Simulation time (s)", simTime);
+  cmd.AddValue ("distance", "Distance (m) between basic service sets", distance);
+  cmd.AddValue ("radius", "Radius (m) of the circle on which the stations of a BSS are placed", radius);
+  cmd.AddValue ("threads", "Comma-separated list of the numbers of threads to compare", threads);
+  cmd.Parse (argc, argv);
+
+  std::cout << std::setw (12) << "threads"
+            << std::setw (12) << "time (s)"
+            << std::setw (12) << "events"
+            << std::setw (14) << "ns per event"
+            << std::setw (12) << "rx packets" << std::endl;
+  std::string runs = "0," + threads;
+  std::size_t start = 0;
+  while (start < runs.size ())
+    {
+      std::size_t end = runs.find (',', start);
+      if (end == std::string::npos)
+        {
+          end = runs.size ();
+        }
+      uint32_t nThreads = std::stoul (runs.substr (start, end - start));
+      start = end + 1;
+
+      double elapsed = Run (nThreads, nBss, nStations, Seconds (simTime), distance, radius);
+      std::cout << std::setw (12) << (nThreads > 0 ? std::to_string (nThreads) : "sequential")
+                << std::setw (12) << elapsed
+                << std::setw (12) << g_events
+                << std::setw (14) << elapsed * 1e9 / g_events
+                << std::setw (12) << g_rxPackets << std::endl;
+    }
+
+  return 0;
+}
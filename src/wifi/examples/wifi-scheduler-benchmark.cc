@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program compares the event schedulers on the events generated by
+// a Wi-Fi network.
+//
+// --nNodes adhoc 802.11a nodes are placed on a circle (--radius option) so
+// that all of them contend for the channel. Each node sends saturated
+// traffic to the next node, hence the event list contains the backoff,
+// Ack timeout, channel reception and PHY events of all the nodes, many
+// of which are cancelled before they expire. The same simulation, lasting
+// --simTime seconds, is run with each scheduler and the wall-clock time,
+// the number of executed events and the number of received packets (which
+// is the same for all the schedulers) are reported.
+//
+
+#include <iomanip>
+#include <iostream>
+#include <cmath>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/wifi-module.h"
+
+using namespace ns3;
+
+uint64_t g_rxPackets = 0; ///< number of packets received by the applications
+uint64_t g_events = 0; ///< number of events executed during the simulation
+
+/**
+ * Application RX trace sink
+ *
+ * \param p the received packet
+ * \param from the sender address
+ */
+void
+AppRx (Ptr<const Packet> p, const Address &from)
+{
+  g_rxPackets++;
+}
+
+/**
+ * Run the simulation
+ *
+ * \param scheduler the type of the scheduler
+ * \param nNodes the number of nodes
+ * \param simTime the simulation time
+ * \param radius the radius of the circle on which nodes are placed
+ * \return the wall-clock duration of the simulation in seconds
+ */
+double
+Run (std::string scheduler, uint32_t nNodes, Time simTime, double radius)
+{
+  g_rxPackets = 0;
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+  ObjectFactory factory;
+  factory.SetTypeId (scheduler);
+  Simulator::SetScheduler (factory);
+
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy;
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate24Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  wifi.AssignStreams (devices, 1);
+
+  // nodes are evenly spaced on a circle, so that the runs with the
+  // different schedulers do not depend on the random streams left over
+  // by the previous runs
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      double angle = 2 * M_PI * i / nNodes;
+      positionAlloc->Add (Vector (radius * std::cos (angle), radius * std::sin (angle), 0));
+    }
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  PacketSocketHelper packetSocket;
+  packetSocket.Install (nodes);
+
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      uint32_t next = (i + 1) % nNodes;
+      PacketSocketAddress socket;
+      socket.SetSingleDevice (devices.Get (i)->GetIfIndex ());
+      socket.SetPhysicalAddress (devices.Get (next)->GetAddress ());
+      socket.SetProtocol (1);
+
+      Ptr<PacketSocketClient> client = CreateObject<PacketSocketClient> ();
+      client->SetAttribute ("PacketSize", UintegerValue (1000));
+      client->SetAttribute ("MaxPackets", UintegerValue (0));
+      client->SetAttribute ("Interval", TimeValue (MicroSeconds (200)));
+      client->SetRemote (socket);
+      nodes.Get (i)->AddApplication (client);
+      client->SetStartTime (MilliSeconds (10 + i));
+
+      Ptr<PacketSocketServer> server = CreateObject<PacketSocketServer> ();
+      server->SetLocal (socket);
+      nodes.Get (next)->AddApplication (server);
+    }
+
+  Config::ConnectWithoutContext ("/NodeList/*/ApplicationList/*/$ns3::PacketSocketServer/Rx",
+                                 MakeCallback (&AppRx));
+
+  Simulator::Stop (simTime);
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  double elapsed = clock.End () / 1000.0;
+  g_events = Simulator::GetEventCount ();
+  Simulator::Destroy ();
+  return elapsed;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nNodes = 20;
+  double simTime = 5;
+  double radius = 10;
+  std::string schedulers = "ns3::MapScheduler,ns3::ListScheduler,ns3::HeapScheduler,"
+                           "ns3::CalendarScheduler,ns3::PriorityQueueScheduler,ns3::DaryHeapScheduler";
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("nNodes", "Number of nodes", nNodes);
+  cmd.AddValue ("simTime", "Simulation time (s)", simTime);
+  cmd.AddValue ("radius", "Radius (m) of the circle on which nodes are placed", radius);
+  cmd.AddValue ("schedulers", "Comma-separated list of the schedulers to compare", schedulers);
+  cmd.Parse (argc, argv);
+
+  std::cout << std::setw (28) << "scheduler"
+            << std::setw (12) << "time (s)"
+            << std::setw (12) << "events"
+            << std::setw (14) << "ns per event"
+            << std::setw (12) << "rx packets" << std::endl;
+  std::size_t start = 0;
+  while (start < schedulers.size ())
+    {
+      std::size_t end = schedulers.find (',', start);
+      if (end == std::string::npos)
+        {
+          end = schedulers.size ();
+        }
+      std::string scheduler = schedulers.substr (start, end - start);
+      start = end + 1;
+
+      double elapsed = Run (scheduler, nNodes, Seconds (simTime), radius);
+      std::cout << std::setw (28) << scheduler
+                << std::setw (12) << elapsed
+                << std::setw (12) << g_events
+                << std::setw (14) << elapsed * 1e9 / g_events
+                << std::setw (12) << g_rxPackets << std::endl;
+    }
+
+  return 0;
+}
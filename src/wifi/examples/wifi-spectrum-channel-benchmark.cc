@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures how the cost of delivering signals over a
+// MultiModelSpectrumChannel scales with the number of nodes attached
+// to the channel, with and without shared PSD delivery (see the
+// MultiModelSpectrumChannel::SharedPsd attribute).
+//
+// Nodes are placed on a disc (--radius option) so that all of them
+// receive every frame. A single node broadcasts --nPackets frames and
+// the wall-clock time of the simulation is reported for a number of
+// nodes starting at --minNodes and doubling up to --maxNodes. The number
+// of frames successfully received by the PHYs is reported as well, and
+// is the same with and without shared PSD delivery, along with the number
+// of PPDUs allocated per transmission (PPDUs are shared by all receivers).
+//
+
+#include <iomanip>
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+#include "ns3/spectrum-module.h"
+#include "ns3/wifi-module.h"
+
+using namespace ns3;
+
+uint64_t g_rxOk = 0; ///< number of frames successfully received by the PHYs
+uint64_t g_ppdus = 0; ///< number of PPDUs created during the simulation
+
+/**
+ * PHY RX end trace sink
+ *
+ * \param p the received packet
+ */
+void
+PhyRxEnd (Ptr<const Packet> p)
+{
+  g_rxOk++;
+}
+
+/**
+ * Broadcast a frame
+ *
+ * \param device the transmitting device
+ * \param size the size of the packet
+ */
+void
+SendFrame (Ptr<NetDevice> device, uint32_t size)
+{
+  device->Send (Create<Packet> (size), device->GetBroadcast (), 0x88b5);
+}
+
+/**
+ * Run the simulation
+ *
+ * \param nNodes the number of nodes
+ * \param sharedPsd whether shared PSD delivery is enabled
+ * \param nPackets the number of packets to broadcast
+ * \param radius the radius of the disc on which nodes are placed
+ * \return the wall-clock duration of the simulation in seconds
+ */
+double
+Run (uint32_t nNodes, bool sharedPsd, uint32_t nPackets, double radius)
+{
+  g_rxOk = 0;
+
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  channel->SetAttribute ("SharedPsd", BooleanValue (sharedPsd));
+  channel->AddPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+  SpectrumWifiPhyHelper phy;
+  phy.SetChannel (channel);
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211ax_5GHZ);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("HeMcs0"),
+                                "ControlMode", StringValue ("HeMcs0"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::UniformDiscPositionAllocator",
+                                 "rho", DoubleValue (radius));
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxEnd",
+                                 MakeCallback (&PhyRxEnd));
+
+  for (uint32_t i = 0; i < nPackets; i++)
+    {
+      Simulator::Schedule (MilliSeconds (1 + i), &SendFrame, devices.Get (0), 1000);
+    }
+
+  uint64_t ppdus = WifiPpdu::GetNCreated ();
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  double elapsed = clock.End () / 1000.0;
+  g_ppdus = WifiPpdu::GetNCreated () - ppdus;
+  Simulator::Destroy ();
+  return elapsed;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t minNodes = 10;
+  uint32_t maxNodes = 160;
+  uint32_t nPackets = 1000;
+  double radius = 10;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("minNodes", "Smallest number of nodes", minNodes);
+  cmd.AddValue ("maxNodes", "Largest number of nodes", maxNodes);
+  cmd.AddValue ("nPackets", "Number of broadcast packets", nPackets);
+  cmd.AddValue ("radius", "Radius (m) of the disc on which nodes are placed", radius);
+  cmd.Parse (argc, argv);
+
+  std::cout << std::setw (8) << "nodes"
+            << std::setw (12) << "shared PSD"
+            << std::setw (12) << "time (s)"
+            << std::setw (12) << "rx frames"
+            << std::setw (12) << "PPDUs/tx" << std::endl;
+  for (uint32_t nNodes = minNodes; nNodes <= maxNodes; nNodes *= 2)
+    {
+      for (bool sharedPsd : {false, true})
+        {
+          double elapsed = Run (nNodes, sharedPsd, nPackets, radius);
+          std::cout << std::setw (8) << nNodes
+                    << std::setw (12) << (sharedPsd ? "yes" : "no")
+                    << std::setw (12) << elapsed
+                    << std::setw (12) << g_rxOk
+                    << std::setw (12) << static_cast<double> (g_ppdus) / nPackets << std::endl;
+        }
+    }
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// This program measures how the per-frame cost of the remote station
+// manager of a device scales with the number of remote stations it knows.
+//
+// A single device is created and --nStations remote stations are added
+// to its remote station manager (--manager option), starting at
+// --minStations and doubling up to --maxStations. For each number of
+// stations, --nFrames frames are addressed to the stations in a random
+// order and, for each frame, the operations performed by the MAC on a
+// successful transmission are invoked: selection of the TXVECTOR, RTS
+// decision, report of the received ACK and of the received frame. The
+// wall-clock time per frame is reported and should not depend on the
+// number of stations.
+//
+
+#include <iomanip>
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+using namespace ns3;
+
+/**
+ * Measure the per-frame cost of a remote station manager
+ *
+ * \param manager the type of the remote station manager
+ * \param nStations the number of remote stations
+ * \param nFrames the number of frames
+ * \return the wall-clock time per frame in nanoseconds
+ */
+double
+Run (std::string manager, uint32_t nStations, uint32_t nFrames)
+{
+  NodeContainer nodes;
+  nodes.Create (1);
+
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  YansWifiPhyHelper phy;
+  phy.SetChannel (channel.Create ());
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211a);
+  wifi.SetRemoteStationManager (manager);
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  Ptr<WifiRemoteStationManager> stationManager =
+    DynamicCast<WifiNetDevice> (devices.Get (0))->GetRemoteStationManager ();
+
+  std::vector<Mac48Address> addresses;
+  for (uint32_t i = 0; i < nStations; i++)
+    {
+      Mac48Address address = Mac48Address::Allocate ();
+      stationManager->AddAllSupportedModes (address);
+      stationManager->RecordGotAssocTxOk (address);
+      addresses.push_back (address);
+    }
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+  std::vector<uint32_t> order;
+  for (uint32_t i = 0; i < nFrames; i++)
+    {
+      order.push_back (random->GetInteger (0, nStations - 1));
+    }
+
+  Ptr<Packet> packet = Create<Packet> (1000);
+  WifiMacHeader header;
+  header.SetType (WIFI_MAC_DATA);
+  header.SetAddr2 (Mac48Address::ConvertFrom (devices.Get (0)->GetAddress ()));
+  RxSignalInfo rxSignalInfo;
+  rxSignalInfo.snr = 100;
+  rxSignalInfo.rssi = -60;
+  WifiMode ackMode = OfdmPhy::GetOfdmRate6Mbps ();
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i : order)
+    {
+      header.SetAddr1 (addresses[i]);
+      WifiTxVector txVector = stationManager->GetDataTxVector (header);
+      stationManager->NeedRts (header, packet->GetSize ());
+      Ptr<const WifiMacQueueItem> mpdu = Create<const WifiMacQueueItem> (packet, header);
+      stationManager->ReportDataOk (mpdu, 100, ackMode, 100, txVector);
+      stationManager->ReportRxOk (addresses[i], rxSignalInfo, txVector);
+    }
+  double elapsed = clock.End ();
+  Simulator::Destroy ();
+  return elapsed * 1e6 / nFrames;
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string manager = "ns3::ConstantRateWifiManager";
+  uint32_t minStations = 8;
+  uint32_t maxStations = 1024;
+  uint32_t nFrames = 1000000;
+
+  CommandLine cmd (__FILE__);
+  cmd.AddValue ("manager", "Type of the remote station manager", manager);
+  cmd.AddValue ("minStations", "Smallest number of remote stations", minStations);
+  cmd.AddValue ("maxStations", "Largest number of remote stations", maxStations);
+  cmd.AddValue ("nFrames", "Number of frames", nFrames);
+  cmd.Parse (argc, argv);
+
+  std::cout << std::setw (10) << "stations"
+            << std::setw (16) << "ns per frame" << std::endl;
+  for (uint32_t nStations = minStations; nStations <= maxStations; nStations *= 2)
+    {
+      double perFrame = Run (manager, nStations, nFrames);
+      std::cout << std::setw (10) << nStations
+                << std::setw (16) << std::fixed << std::setprecision (1) << perFrame << std::endl;
+    }
+  return 0;
+}
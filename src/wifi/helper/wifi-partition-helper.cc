@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/simulator.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/node-list.h"
+#include "ns3/net-device.h"
+#include "ns3/channel.h"
+#include "ns3/yans-wifi-channel.h"
+#include "wifi-partition-helper.h"
+#include <set>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WifiPartitionHelper");
+
+WifiPartitionHelper::WifiPartitionHelper ()
+{
+}
+
+Ptr<MultithreadedSimulatorImpl>
+WifiPartitionHelper::GetSimulatorImpl (void) const
+{
+  Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+  NS_ABORT_MSG_IF (impl == 0, "The simulator implementation must be ns3::MultithreadedSimulatorImpl");
+  return impl;
+}
+
+void
+WifiPartitionHelper::SetPartition (NodeContainer nodes, uint32_t partition) const
+{
+  Ptr<MultithreadedSimulatorImpl> impl = GetSimulatorImpl ();
+  for (NodeContainer::Iterator i = nodes.Begin (); i != nodes.End (); ++i)
+    {
+      impl->SetPartition ((*i)->GetId (), partition);
+    }
+}
+
+Time
+WifiPartitionHelper::Install (void) const
+{
+  Ptr<MultithreadedSimulatorImpl> impl = GetSimulatorImpl ();
+  std::set<Ptr<Channel> > channels;
+  for (NodeList::Iterator i = NodeList::Begin (); i != NodeList::End (); ++i)
+    {
+      for (uint32_t j = 0; j < (*i)->GetNDevices (); j++)
+        {
+          Ptr<Channel> channel = (*i)->GetDevice (j)->GetChannel ();
+          if (channel != 0)
+            {
+              channels.insert (channel);
+            }
+        }
+    }
+
+  Time lookahead = Time::Max ();
+  for (const auto & channel : channels)
+    {
+      Ptr<YansWifiChannel> yansChannel = DynamicCast<YansWifiChannel> (channel);
+      if (yansChannel != 0)
+        {
+          lookahead = std::min (lookahead, yansChannel->PreparePartitions ());
+          continue;
+        }
+      std::set<uint32_t> partitions;
+      for (std::size_t j = 0; j < channel->GetNDevices (); j++)
+        {
+          partitions.insert (impl->GetPartition (channel->GetDevice (j)->GetNode ()->GetId ()));
+        }
+      NS_ABORT_MSG_IF (partitions.size () > 1, "The devices attached to a " << channel->GetInstanceTypeId ().GetName ()
+                       << " must belong to the same partition");
+    }
+  NS_ABORT_MSG_IF (!lookahead.IsStrictlyPositive (), "Nodes of different partitions are at the same position");
+  NS_LOG_DEBUG ("partitions=" << impl->GetNPartitions () << ", lookahead=" << lookahead);
+  impl->SetAttribute ("Lookahead", TimeValue (lookahead));
+  return lookahead;
+}
+
+} //namespace ns3
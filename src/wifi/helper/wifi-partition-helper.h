@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_PARTITION_HELPER_H
+#define WIFI_PARTITION_HELPER_H
+
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+class MultithreadedSimulatorImpl;
+
+/**
+ * \ingroup wifi
+ *
+ * Helper to partition the nodes of a wireless network among the threads
+ * of a multithreaded simulation (see ns3::MultithreadedSimulatorImpl).
+ *
+ * The simulator implementation must be set to
+ * ns3::MultithreadedSimulatorImpl (with the SimulatorImplementationType
+ * global value) before the nodes are created. The nodes are assigned to
+ * partitions with SetPartition, then Install prepares the channels and
+ * sets the lookahead of the simulator to the minimum propagation delay
+ * between nodes of different partitions, hence it must be called once
+ * the devices and the mobility models are installed.
+ *
+ * Only YansWifiChannel supports PHYs in several partitions; the devices
+ * attached to any other channel must belong to the same partition.
+ */
+class WifiPartitionHelper
+{
+public:
+  WifiPartitionHelper ();
+
+  /**
+   * Assign nodes to a partition.
+   *
+   * \param nodes the nodes
+   * \param partition the partition
+   */
+  void SetPartition (NodeContainer nodes, uint32_t partition) const;
+  /**
+   * Prepare the channels of all the nodes for the partitions and set the
+   * lookahead of the simulator.
+   *
+   * \return the lookahead, i.e., the minimum propagation delay between
+   *         nodes of different partitions
+   */
+  Time Install (void) const;
+
+private:
+  /**
+   * \return the simulator implementation
+   */
+  Ptr<MultithreadedSimulatorImpl> GetSimulatorImpl (void) const;
+};
+
+} //namespace ns3
+
+#endif /* WIFI_PARTITION_HELPER_H */
@@ -21,6 +21,7 @@
 #ifndef ERROR_RATE_MODEL_H
 #define ERROR_RATE_MODEL_H
 
+#include <vector>
 #include "ns3/object.h"
 #include "wifi-mode.h"
 
@@ -86,6 +87,27 @@ public:
                               uint8_t numRxAntennas = 1, WifiPpduField field = WIFI_PPDU_FIELD_DATA,
                               uint16_t staId = SU_STA_ID) const;
 
+  /**
+   * This method returns the probabilities that the given chunks of a packet,
+   * all sent with the same mode, will be successfully received by the PHY.
+   * It is equivalent to calling GetChunkSuccessRate for each chunk, but
+   * allows subclasses to share the work that does not depend on the SNR
+   * and size of the chunks.
+   *
+   * \param mode the Wi-Fi mode applicable to the chunks
+   * \param txVector TXVECTOR of the overall transmission
+   * \param snrs the SNR of each chunk
+   * \param nbits the number of bits in each chunk
+   * \param successRates the probability of successfully receiving each chunk (resized to the number of chunks)
+   * \param numRxAntennas the number of active RX antennas (1 if not provided)
+   * \param field the PPDU field to which the chunks belong to (assumes this is for the payload part if not provided)
+   * \param staId the station ID for MU
+   */
+  void GetChunkSuccessRates (WifiMode mode, const WifiTxVector& txVector, const std::vector<double>& snrs,
+                             const std::vector<uint64_t>& nbits, std::vector<double>& successRates,
+                             uint8_t numRxAntennas = 1, WifiPpduField field = WIFI_PPDU_FIELD_DATA,
+                             uint16_t staId = SU_STA_ID) const;
+
   /**
    * Assign a fixed random variable stream number to the random variables
    * used by this model. Return the number of streams (possibly zero) that
@@ -113,6 +135,22 @@ private:
    */
   virtual double DoGetChunkSuccessRate (WifiMode mode, const WifiTxVector& txVector, double snr, uint64_t nbits,
                                         uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const = 0;
+  /**
+   * Compute the success rates of several chunks sent with the same (non-DSSS)
+   * mode. The default implementation calls DoGetChunkSuccessRate for each chunk.
+   *
+   * \param mode the Wi-Fi mode applicable to the chunks
+   * \param txVector TXVECTOR of the overall transmission
+   * \param snrs the SNR of each chunk
+   * \param nbits the number of bits in each chunk
+   * \param successRates the probability of successfully receiving each chunk (already sized)
+   * \param numRxAntennas the number of active RX antennas
+   * \param field the PPDU field to which the chunks belong to
+   * \param staId the station ID for MU
+   */
+  virtual void DoGetChunkSuccessRates (WifiMode mode, const WifiTxVector& txVector, const std::vector<double>& snrs,
+                                       const std::vector<uint64_t>& nbits, std::vector<double>& successRates,
+                                       uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const;
 };
 
 } //namespace ns3
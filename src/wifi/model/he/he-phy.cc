@@ -314,12 +314,12 @@ HePhy::BuildPpdu (const WifiConstPsduMap & psdus, const WifiTxVector& txVector,
 }
 
 void
-HePhy::StartReceivePreamble (Ptr<WifiPpdu> ppdu, RxPowerWattPerChannelBand rxPowersW,
+HePhy::StartReceivePreamble (Ptr<const WifiPpdu> ppdu, RxPowerWattPerChannelBand rxPowersW,
                              Time rxDuration)
 {
   NS_LOG_FUNCTION (this << ppdu << rxDuration);
   const WifiTxVector& txVector = ppdu->GetTxVector ();
-  auto hePpdu = DynamicCast<HePpdu> (ppdu);
+  auto hePpdu = DynamicCast<const HePpdu> (ppdu);
   NS_ASSERT (hePpdu);
   HePpdu::TxPsdFlag psdFlag = hePpdu->GetTxPsdFlag ();
   if (txVector.GetPreambleType () == WIFI_PREAMBLE_HE_TB
@@ -826,7 +826,7 @@ HePhy::ObtainNextUid (const WifiTxVector& txVector)
     }
   else
     {
-      uid = m_globalPpduUid++;
+      uid = ObtainNextGlobalUid ();
     }
   m_previouslyTxPpduUid = uid; //to be able to identify solicited HE TB PPDUs
   return uid;
@@ -931,7 +931,7 @@ HePhy::GetTransmissionChannelWidth (Ptr<const WifiPpdu> ppdu) const
 }
 
 bool
-HePhy::CanReceivePpdu (Ptr<WifiPpdu> ppdu, uint16_t txCenterFreq) const
+HePhy::CanReceivePpdu (Ptr<const WifiPpdu> ppdu, uint16_t txCenterFreq) const
 {
   NS_LOG_FUNCTION (this << ppdu << txCenterFreq);
 
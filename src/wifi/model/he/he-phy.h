@@ -93,7 +93,7 @@ public:
                            const WifiTxVector& txVector,
                            Time ppduDuration) override;
   Ptr<const WifiPsdu> GetAddressedPsduInPpdu (Ptr<const WifiPpdu> ppdu) const override;
-  void StartReceivePreamble (Ptr<WifiPpdu> ppdu,
+  void StartReceivePreamble (Ptr<const WifiPpdu> ppdu,
                              RxPowerWattPerChannelBand rxPowersW,
                              Time rxDuration) override;
   void CancelAllEvents (void) override;
@@ -102,7 +102,7 @@ public:
   void StartTx (Ptr<WifiPpdu> ppdu) override;
   uint16_t GetTransmissionChannelWidth (Ptr<const WifiPpdu> ppdu) const override;
   Time CalculateTxDuration (WifiConstPsduMap psduMap, const WifiTxVector& txVector, WifiPhyBand band) const override;
-  bool CanReceivePpdu (Ptr<WifiPpdu> ppdu, uint16_t txCenterFreq) const override;
+  bool CanReceivePpdu (Ptr<const WifiPpdu> ppdu, uint16_t txCenterFreq) const override;
 
   /**
    * \return the BSS color of this PHY.
@@ -38,8 +38,11 @@ NS_LOG_COMPONENT_DEFINE ("InterferenceHelper");
  *       PHY event class
  ****************************************************************/
 
+thread_local uint64_t Event::m_nextUid = 1;
+
 Event::Event (Ptr<const WifiPpdu> ppdu, const WifiTxVector& txVector, Time duration, RxPowerWattPerChannelBand rxPower)
-  : m_ppdu (ppdu),
+  : m_uid (m_nextUid++),
+    m_ppdu (ppdu),
     m_txVector (txVector),
     m_startTime (Simulator::Now ()),
     m_endTime (m_startTime + duration),
@@ -125,6 +128,12 @@ Event::UpdateRxPowerW (RxPowerWattPerChannelBand rxPower)
     }
 }
 
+uint64_t
+Event::GetUid (void) const
+{
+  return m_uid;
+}
+
 std::ostream & operator << (std::ostream &os, const Event &event)
 {
   os << "start=" << event.GetStartTime () << ", end=" << event.GetEndTime ()
@@ -176,7 +185,8 @@ InterferenceHelper::NiChange::GetEvent (void) const
 InterferenceHelper::InterferenceHelper ()
   : m_errorRateModel (0),
     m_numRxAntennas (1),
-    m_rxing (false)
+    m_rxing (false),
+    m_timelineType (TIMELINE_MULTIMAP)
 {
 }
 
@@ -207,6 +217,29 @@ InterferenceHelper::AddForeignSignal (Time duration, RxPowerWattPerChannelBand r
   Add (fakePpdu, WifiTxVector (), duration, rxPowerW);
 }
 
+void
+InterferenceHelper::SetTimelineType (TimelineType type)
+{
+  NS_LOG_FUNCTION (this << type);
+  if (type == m_timelineType)
+    {
+      return;
+    }
+  std::vector<WifiSpectrumBand> bands = m_bands;
+  RemoveBands ();
+  m_timelineType = type;
+  for (const auto & band : bands)
+    {
+      AddBand (band);
+    }
+}
+
+InterferenceHelper::TimelineType
+InterferenceHelper::GetTimelineType (void) const
+{
+  return m_timelineType;
+}
+
 void
 InterferenceHelper::RemoveBands(void)
 {
@@ -217,13 +250,24 @@ InterferenceHelper::RemoveBands(void)
     }
   m_niChangesPerBand.clear();
   m_firstPowerPerBand.clear();
+  m_bandIds.clear ();
+  m_flatNiChanges.clear ();
+  m_bands.clear ();
 }
 
 void
 InterferenceHelper::AddBand (WifiSpectrumBand band)
 {
   NS_LOG_FUNCTION (this << band.first << band.second);
-  NS_ASSERT (m_niChangesPerBand.find (band) == m_niChangesPerBand.end ());
+  NS_ASSERT (std::find (m_bands.begin (), m_bands.end (), band) == m_bands.end ());
+  m_bands.push_back (band);
+  if (m_timelineType == TIMELINE_FLAT)
+    {
+      m_bandIds.insert ({band, m_flatNiChanges.size ()});
+      m_flatNiChanges.emplace_back ();
+      ResetFlatNiChanges (&m_flatNiChanges.back ());
+      return;
+    }
   NiChanges niChanges;
   m_niChangesPerBand.insert ({band, niChanges});
   // Always have a zero power noise event in the list
@@ -259,6 +303,21 @@ Time
 InterferenceHelper::GetEnergyDuration (double energyW, WifiSpectrumBand band)
 {
   Time now = Simulator::Now ();
+  if (m_timelineType == TIMELINE_FLAT)
+    {
+      const FlatNiChanges &nis = GetFlatNiChanges (band);
+      std::size_t i = GetPreviousIndex (now, nis);
+      Time end = nis.m_entries[i].time;
+      for (; i < nis.m_entries.size (); ++i)
+        {
+          end = nis.m_entries[i].time;
+          if (nis.m_entries[i].power < energyW)
+            {
+              break;
+            }
+        }
+      return end > now ? end - now : MicroSeconds (0);
+    }
   auto i = GetPreviousPosition (now, band);
   Time end = i->first;
   auto ni_it = m_niChangesPerBand.find (band);
@@ -280,6 +339,43 @@ InterferenceHelper::AppendEvent (Ptr<Event> event, bool isStartOfdmaRxing)
 {
   NS_LOG_FUNCTION (this << event << isStartOfdmaRxing);
   RxPowerWattPerChannelBand rxPowerWattPerChannelBand = event->GetRxPowerWPerBand ();
+  if (m_timelineType == TIMELINE_FLAT)
+    {
+      for (auto const& it : rxPowerWattPerChannelBand)
+        {
+          FlatNiChanges &nis = GetFlatNiChanges (it.first);
+          double previousPowerStart = nis.m_entries[GetPreviousIndex (event->GetStartTime (), nis)].power;
+          double previousPowerEnd = nis.m_entries[GetPreviousIndex (event->GetEndTime (), nis)].power;
+          if (!m_rxing)
+            {
+              nis.m_firstPower = previousPowerStart;
+              // Prune the changes up to the start of the event: the last
+              // pruned entry becomes the zero power change at time 0
+              std::size_t next = GetNextIndex (event->GetStartTime (), nis);
+              if (next - 1 > nis.m_head)
+                {
+                  nis.m_head = next - 1;
+                  nis.m_entries[nis.m_head] = {Time (0), 0.0, 0};
+                  if (nis.m_head * 2 > nis.m_entries.size ())
+                    {
+                      nis.m_entries.erase (nis.m_entries.begin (), nis.m_entries.begin () + nis.m_head);
+                      nis.m_head = 0;
+                    }
+                }
+            }
+          else if (isStartOfdmaRxing)
+            {
+              nis.m_firstPower = previousPowerStart;
+            }
+          std::size_t first = AddFlatNiChange ({event->GetStartTime (), previousPowerStart, event->GetUid ()}, &nis);
+          std::size_t last = AddFlatNiChange ({event->GetEndTime (), previousPowerEnd, event->GetUid ()}, &nis);
+          for (std::size_t i = first; i != last; ++i)
+            {
+              nis.m_entries[i].power += it.second;
+            }
+        }
+      return;
+    }
   for (auto const& it : rxPowerWattPerChannelBand)
     {
       WifiSpectrumBand band = it.first;
@@ -319,6 +415,17 @@ InterferenceHelper::UpdateEvent (Ptr<Event> event, RxPowerWattPerChannelBand rxP
   for (auto const& it : rxPower)
     {
       WifiSpectrumBand band = it.first;
+      if (m_timelineType == TIMELINE_FLAT)
+        {
+          FlatNiChanges &nis = GetFlatNiChanges (band);
+          std::size_t first = GetPreviousIndex (event->GetStartTime (), nis);
+          std::size_t last = GetPreviousIndex (event->GetEndTime (), nis);
+          for (std::size_t i = first; i != last; ++i)
+            {
+              nis.m_entries[i].power += it.second;
+            }
+          continue;
+        }
       auto ni_it = m_niChangesPerBand.find (band);
       NS_ASSERT (ni_it != m_niChangesPerBand.end ());
       auto first = GetPreviousPosition (event->GetStartTime (), band);
@@ -358,30 +465,58 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, uint1
 }
 
 double
-InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChangesPerBand *nis, WifiSpectrumBand band) const
+InterferenceHelper::CalculateNoiseInterferenceW (Ptr<Event> event, NiChangesSpan *nis, WifiSpectrumBand band) const
 {
   NS_LOG_FUNCTION (this << band.first << band.second);
-  auto firstPower_it = m_firstPowerPerBand.find (band);
-  NS_ASSERT (firstPower_it != m_firstPowerPerBand.end ());
-  double noiseInterferenceW = firstPower_it->second;
-  auto ni_it = m_niChangesPerBand.find (band);
-  NS_ASSERT (ni_it != m_niChangesPerBand.end ());
-  auto it = ni_it->second.find (event->GetStartTime ());
-  for (; it != ni_it->second.end () && it->first < Simulator::Now (); ++it)
+  double noiseInterferenceW;
+  if (m_timelineType == TIMELINE_FLAT)
     {
-      noiseInterferenceW = it->second.GetPower () - event->GetRxPowerW (band);
+      const FlatNiChanges &flat = GetFlatNiChanges (band);
+      noiseInterferenceW = flat.m_firstPower;
+      // Changes of a band are contiguous and sorted by time, hence the
+      // changes spanning the event are directly viewed in the timeline
+      auto it = std::lower_bound (flat.m_entries.begin () + flat.m_head, flat.m_entries.end (), event->GetStartTime (),
+                                  [] (const NiChangeEntry &change, Time moment) { return change.time < moment; });
+      NS_ASSERT (it != flat.m_entries.end () && it->time == event->GetStartTime ());
+      for (auto i = it; i != flat.m_entries.end () && i->time < Simulator::Now (); ++i)
+        {
+          noiseInterferenceW = i->power - event->GetRxPowerW (band);
+        }
+      for (; it != flat.m_entries.end () && it->eventUid != event->GetUid (); ++it);
+      NS_ASSERT (it != flat.m_entries.end ());
+      auto last = it;
+      while (++last != flat.m_entries.end () && last->eventUid != event->GetUid ());
+      NS_ASSERT (last != flat.m_entries.end ());
+      nis->begin = &(*it);
+      nis->end = &(*last) + 1;
+      nis->firstPower = flat.m_firstPower;
     }
-  it = ni_it->second.find (event->GetStartTime ());
-  NS_ASSERT (it != ni_it->second.end ());
-  for (; it != ni_it->second.end () && it->second.GetEvent () != event; ++it);
-  NiChanges ni;
-  ni.emplace (event->GetStartTime (), NiChange (0, event));
-  while (++it != ni_it->second.end () && it->second.GetEvent () != event)
+  else
     {
-      ni.insert (*it);
+      auto firstPower_it = m_firstPowerPerBand.find (band);
+      NS_ASSERT (firstPower_it != m_firstPowerPerBand.end ());
+      noiseInterferenceW = firstPower_it->second;
+      auto ni_it = m_niChangesPerBand.find (band);
+      NS_ASSERT (ni_it != m_niChangesPerBand.end ());
+      auto it = ni_it->second.find (event->GetStartTime ());
+      for (; it != ni_it->second.end () && it->first < Simulator::Now (); ++it)
+        {
+          noiseInterferenceW = it->second.GetPower () - event->GetRxPowerW (band);
+        }
+      it = ni_it->second.find (event->GetStartTime ());
+      NS_ASSERT (it != ni_it->second.end ());
+      for (; it != ni_it->second.end () && it->second.GetEvent () != event; ++it);
+      m_niChangesScratch.clear ();
+      m_niChangesScratch.push_back ({event->GetStartTime (), 0, event->GetUid ()});
+      while (++it != ni_it->second.end () && it->second.GetEvent () != event)
+        {
+          m_niChangesScratch.push_back ({it->first, it->second.GetPower (), 0});
+        }
+      m_niChangesScratch.push_back ({event->GetEndTime (), 0, event->GetUid ()});
+      nis->begin = m_niChangesScratch.data ();
+      nis->end = m_niChangesScratch.data () + m_niChangesScratch.size ();
+      nis->firstPower = firstPower_it->second;
     }
-  ni.emplace (event->GetEndTime (), NiChange (0, event));
-  nis->insert ({band, ni});
   NS_ASSERT_MSG (noiseInterferenceW >= 0, "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
   return noiseInterferenceW;
 }
@@ -416,63 +551,81 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate (double snir, Time duration
 
 double
 InterferenceHelper::CalculatePayloadPer (Ptr<const Event> event, uint16_t channelWidth,
-                                         NiChangesPerBand *nis, WifiSpectrumBand band,
+                                         const NiChangesSpan &nis, WifiSpectrumBand band,
                                          uint16_t staId, std::pair<Time, Time> window) const
 {
   NS_LOG_FUNCTION (this << channelWidth << band.first << band.second << staId << window.first << window.second);
-  double psr = 1.0; /* Packet Success Rate */
-  auto ni_it = nis->find (band)->second;
-  auto j = ni_it.begin ();
-  Time previous = j->first;
-  WifiMode payloadMode = event->GetTxVector ().GetMode (staId);
-  Time phyPayloadStart = j->first;
-  if (event->GetPpdu ()->GetType () != WIFI_PPDU_TYPE_UL_MU) //j->first corresponds to the start of the UL-OFDMA payload
+  const NiChangeEntry *j = nis.begin;
+  Time previous = j->time;
+  const WifiTxVector& txVector = event->GetTxVector ();
+  WifiMode payloadMode = txVector.GetMode (staId);
+  // same number of bits as computed by CalculatePayloadChunkSuccessRate
+  uint64_t rate = payloadMode.GetDataRate (txVector, staId);
+  uint8_t nss = txVector.GetNss (staId);
+  Time phyPayloadStart = j->time;
+  if (event->GetPpdu ()->GetType () != WIFI_PPDU_TYPE_UL_MU) //j->time corresponds to the start of the UL-OFDMA payload
     {
-      phyPayloadStart = j->first + WifiPhy::CalculatePhyPreambleAndHeaderDuration (event->GetTxVector ());
+      phyPayloadStart = j->time + WifiPhy::CalculatePhyPreambleAndHeaderDuration (txVector);
     }
   Time windowStart = phyPayloadStart + window.first;
   Time windowEnd = phyPayloadStart + window.second;
-  double noiseInterferenceW = m_firstPowerPerBand.find (band)->second;
+  double noiseInterferenceW = nis.firstPower;
   double powerW = event->GetRxPowerW (band);
-  while (++j != ni_it.end ())
+  m_chunkSnrs.clear ();
+  m_chunkBits.clear ();
+  while (++j != nis.end)
     {
-      Time current = j->first;
+      Time current = j->time;
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
-      double snr = CalculateSnr (powerW, noiseInterferenceW, channelWidth, event->GetTxVector ().GetNss (staId));
+      double snr = CalculateSnr (powerW, noiseInterferenceW, channelWidth, nss);
+      Time duration;
       //Case 1: Both previous and current point to the windowed payload
       if (previous >= windowStart)
         {
-          psr *= CalculatePayloadChunkSuccessRate (snr, Min (windowEnd, current) - previous, event->GetTxVector (), staId);
-          NS_LOG_DEBUG ("Both previous and current point to the windowed payload: mode=" << payloadMode << ", psr=" << psr);
+          duration = Min (windowEnd, current) - previous;
+          NS_LOG_DEBUG ("Both previous and current point to the windowed payload: mode=" << payloadMode << ", snr=" << snr);
         }
       //Case 2: previous is before windowed payload and current is in the windowed payload
       else if (current >= windowStart)
         {
-          psr *= CalculatePayloadChunkSuccessRate (snr, Min (windowEnd, current) - windowStart, event->GetTxVector (), staId);
-          NS_LOG_DEBUG ("previous is before windowed payload and current is in the windowed payload: mode=" << payloadMode << ", psr=" << psr);
+          duration = Min (windowEnd, current) - windowStart;
+          NS_LOG_DEBUG ("previous is before windowed payload and current is in the windowed payload: mode=" << payloadMode << ", snr=" << snr);
+        }
+      if (!duration.IsZero ())
+        {
+          m_chunkSnrs.push_back (snr);
+          //divide effective number of bits by NSS to achieve same chunk error rate as SISO for AWGN
+          m_chunkBits.push_back (static_cast<uint64_t> (rate * duration.GetSeconds ()) / nss);
         }
-      noiseInterferenceW = j->second.GetPower () - powerW;
-      previous = j->first;
+      noiseInterferenceW = j->power - powerW;
+      previous = j->time;
       if (previous > windowEnd)
         {
           NS_LOG_DEBUG ("Stop: new previous=" << previous << " after time window end=" << windowEnd);
           break;
         }
     }
+  m_errorRateModel->GetChunkSuccessRates (payloadMode, txVector, m_chunkSnrs, m_chunkBits, m_chunkSuccessRates,
+                                          m_numRxAntennas, WIFI_PPDU_FIELD_DATA, staId);
+  double psr = 1.0; /* Packet Success Rate */
+  for (const auto & csr : m_chunkSuccessRates)
+    {
+      psr *= csr;
+    }
+  NS_LOG_DEBUG ("mode=" << payloadMode << ", chunks=" << m_chunkSuccessRates.size () << ", psr=" << psr);
   double per = 1 - psr;
   return per;
 }
 
 double
-InterferenceHelper::CalculatePhyHeaderSectionPsr (Ptr<const Event> event, NiChangesPerBand *nis,
+InterferenceHelper::CalculatePhyHeaderSectionPsr (Ptr<const Event> event, const NiChangesSpan &nis,
                                                   uint16_t channelWidth, WifiSpectrumBand band,
                                                   PhyEntity::PhyHeaderSections phyHeaderSections) const
 {
   NS_LOG_FUNCTION (this << band.first << band.second);
   double psr = 1.0; /* Packet Success Rate */
-  auto ni_it = nis->find (band)->second;
-  auto j = ni_it.begin ();
+  const NiChangeEntry *j = nis.begin;
 
   NS_ASSERT (!phyHeaderSections.empty ());
   Time stopLastSection = Seconds (0);
@@ -481,12 +634,12 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr (Ptr<const Event> event, NiChan
       stopLastSection = Max (stopLastSection, section.second.first.second);
     }
 
-  Time previous = j->first;
-  double noiseInterferenceW = m_firstPowerPerBand.find (band)->second;
+  Time previous = j->time;
+  double noiseInterferenceW = nis.firstPower;
   double powerW = event->GetRxPowerW (band);
-  while (++j != ni_it.end ())
+  while (++j != nis.end)
     {
-      Time current = j->first;
+      Time current = j->time;
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
       double snr = CalculateSnr (powerW, noiseInterferenceW, channelWidth, 1);
@@ -506,8 +659,8 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr (Ptr<const Event> event, NiChan
                 }
             }
         }
-      noiseInterferenceW = j->second.GetPower () - powerW;
-      previous = j->first;
+      noiseInterferenceW = j->power - powerW;
+      previous = j->time;
       if (previous > stopLastSection)
         {
           NS_LOG_DEBUG ("Stop: new previous=" << previous << " after stop of last section=" << stopLastSection);
@@ -518,16 +671,15 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr (Ptr<const Event> event, NiChan
 }
 
 double
-InterferenceHelper::CalculatePhyHeaderPer (Ptr<const Event> event, NiChangesPerBand *nis,
+InterferenceHelper::CalculatePhyHeaderPer (Ptr<const Event> event, const NiChangesSpan &nis,
                                            uint16_t channelWidth, WifiSpectrumBand band,
                                            WifiPpduField header) const
 {
   NS_LOG_FUNCTION (this << band.first << band.second << header);
-  auto ni_it = nis->find (band)->second;
   auto phyEntity = WifiPhy::GetStaticPhyEntity (event->GetTxVector ().GetModulationClass ());
 
   PhyEntity::PhyHeaderSections sections;
-  for (const auto & section : phyEntity->GetPhyHeaderSections (event->GetTxVector (), ni_it.begin ()->first))
+  for (const auto & section : phyEntity->GetPhyHeaderSections (event->GetTxVector (), nis.begin->time))
     {
       if (section.first == header)
         {
@@ -548,7 +700,7 @@ InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, uint16_t channelWi
                                             uint16_t staId, std::pair<Time, Time> relativeMpduStartStop) const
 {
   NS_LOG_FUNCTION (this << channelWidth << band.first << band.second << staId << relativeMpduStartStop.first << relativeMpduStartStop.second);
-  NiChangesPerBand ni;
+  NiChangesSpan ni;
   double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni, band);
   double snr = CalculateSnr (event->GetRxPowerW (band),
                              noiseInterferenceW,
@@ -558,7 +710,7 @@ InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, uint16_t channelWi
   /* calculate the SNIR at the start of the MPDU (located through windowing) and accumulate
    * all SNIR changes in the SNIR vector.
    */
-  double per = CalculatePayloadPer (event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+  double per = CalculatePayloadPer (event, channelWidth, ni, band, staId, relativeMpduStartStop);
 
   return PhyEntity::SnrPer (snr, per);
 }
@@ -566,7 +718,7 @@ InterferenceHelper::CalculatePayloadSnrPer (Ptr<Event> event, uint16_t channelWi
 double
 InterferenceHelper::CalculateSnr (Ptr<Event> event, uint16_t channelWidth, uint8_t nss, WifiSpectrumBand band) const
 {
-  NiChangesPerBand ni;
+  NiChangesSpan ni;
   double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni, band);
   double snr = CalculateSnr (event->GetRxPowerW (band),
                              noiseInterferenceW,
@@ -580,7 +732,7 @@ InterferenceHelper::CalculatePhyHeaderSnrPer (Ptr<Event> event, uint16_t channel
                                               WifiPpduField header) const
 {
   NS_LOG_FUNCTION (this << band.first << band.second << header);
-  NiChangesPerBand ni;
+  NiChangesSpan ni;
   double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni, band);
   double snr = CalculateSnr (event->GetRxPowerW (band),
                              noiseInterferenceW,
@@ -590,7 +742,7 @@ InterferenceHelper::CalculatePhyHeaderSnrPer (Ptr<Event> event, uint16_t channel
   /* calculate the SNIR at the start of the PHY header and accumulate
    * all SNIR changes in the SNIR vector.
    */
-  double per = CalculatePhyHeaderPer (event, &ni, channelWidth, band, header);
+  double per = CalculatePhyHeaderPer (event, ni, channelWidth, band, header);
   
   return PhyEntity::SnrPer (snr, per);
 }
@@ -598,6 +750,18 @@ InterferenceHelper::CalculatePhyHeaderSnrPer (Ptr<Event> event, uint16_t channel
 void
 InterferenceHelper::EraseEvents (void)
 {
+  if (m_timelineType == TIMELINE_FLAT)
+    {
+      // Like the multimap timeline, keep the recorded changes so that
+      // signals that are still on the medium are accounted for after
+      // a channel switch; only the first power of each band is reset
+      for (auto & nis : m_flatNiChanges)
+        {
+          nis.m_firstPower = 0.0;
+        }
+      m_rxing = false;
+      return;
+    }
   for (auto it : m_niChangesPerBand)
     {
       it.second.clear ();
@@ -634,6 +798,56 @@ InterferenceHelper::AddNiChangeEvent (Time moment, NiChange change, WifiSpectrum
   return it->second.insert (GetNextPosition (moment, band), std::make_pair (moment, change));
 }
 
+InterferenceHelper::FlatNiChanges&
+InterferenceHelper::GetFlatNiChanges (WifiSpectrumBand band)
+{
+  auto it = m_bandIds.find (band);
+  NS_ASSERT (it != m_bandIds.end ());
+  return m_flatNiChanges[it->second];
+}
+
+const InterferenceHelper::FlatNiChanges&
+InterferenceHelper::GetFlatNiChanges (WifiSpectrumBand band) const
+{
+  auto it = m_bandIds.find (band);
+  NS_ASSERT (it != m_bandIds.end ());
+  return m_flatNiChanges[it->second];
+}
+
+std::size_t
+InterferenceHelper::GetNextIndex (Time moment, const FlatNiChanges &nis)
+{
+  auto it = std::upper_bound (nis.m_entries.begin () + nis.m_head, nis.m_entries.end (), moment,
+                              [] (Time t, const NiChangeEntry &change) { return t < change.time; });
+  return it - nis.m_entries.begin ();
+}
+
+std::size_t
+InterferenceHelper::GetPreviousIndex (Time moment, const FlatNiChanges &nis)
+{
+  // This is safe since there is always an NI change at time 0,
+  // before moment.
+  return GetNextIndex (moment, nis) - 1;
+}
+
+std::size_t
+InterferenceHelper::AddFlatNiChange (const NiChangeEntry &change, FlatNiChanges *nis)
+{
+  std::size_t next = GetNextIndex (change.time, *nis);
+  nis->m_entries.insert (nis->m_entries.begin () + next, change);
+  return next;
+}
+
+void
+InterferenceHelper::ResetFlatNiChanges (FlatNiChanges *nis)
+{
+  nis->m_entries.clear ();
+  // Always have a zero power noise event in the timeline
+  nis->m_entries.push_back ({Time (0), 0.0, 0});
+  nis->m_head = 0;
+  nis->m_firstPower = 0.0;
+}
+
 void
 InterferenceHelper::NotifyRxStart ()
 {
@@ -647,6 +861,17 @@ InterferenceHelper::NotifyRxEnd (Time endTime)
   NS_LOG_FUNCTION (this << endTime);
   m_rxing = false;
   //Update m_firstPowerPerBand for frame capture
+  if (m_timelineType == TIMELINE_FLAT)
+    {
+      for (auto & nis : m_flatNiChanges)
+        {
+          NS_ASSERT (nis.m_entries.size () - nis.m_head > 1);
+          std::size_t i = GetPreviousIndex (endTime, nis);
+          NS_ASSERT (i > nis.m_head);
+          nis.m_firstPower = nis.m_entries[i - 1].power;
+        }
+      return;
+    }
   for (auto ni : m_niChangesPerBand)
     {
       NS_ASSERT (ni.second.size () > 1);
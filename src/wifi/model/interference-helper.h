@@ -104,9 +104,17 @@ public:
    * \param rxPower the received power (W) for all bands.
    */
   void UpdateRxPowerW (RxPowerWattPerChannelBand rxPower);
+  /**
+   * Return the unique identifier of this event.
+   *
+   * \return the unique identifier of this event
+   */
+  uint64_t GetUid (void) const;
 
 
 private:
+  static thread_local uint64_t m_nextUid; //!< unique identifier of the next event, per thread
+  uint64_t m_uid;                       //!< unique identifier
   Ptr<const WifiPpdu> m_ppdu;           //!< PPDU
   WifiTxVector m_txVector;              //!< TXVECTOR
   Time m_startTime;                     //!< start time
@@ -134,6 +142,33 @@ public:
   InterferenceHelper ();
   ~InterferenceHelper ();
 
+  /**
+   * Storage used to record the noise and interference changes of each band.
+   */
+  enum TimelineType
+  {
+    /** Per-band std::multimap of NI changes holding a reference to their event */
+    TIMELINE_MULTIMAP = 0,
+    /** Per-band time-ordered array indexed by a band ID, pruned in place */
+    TIMELINE_FLAT
+  };
+
+  /**
+   * Select the storage used to record noise and interference changes.
+   * The bands that have been added so far are kept, but the recorded
+   * changes are discarded, hence this should be called before any
+   * signal is added.
+   *
+   * \param type the timeline type
+   */
+  void SetTimelineType (TimelineType type);
+  /**
+   * Return the storage used to record noise and interference changes.
+   *
+   * \return the timeline type
+   */
+  TimelineType GetTimelineType (void) const;
+
   /**
    * Add a frequency band.
    *
@@ -356,6 +391,41 @@ private:
    */
   typedef std::map <WifiSpectrumBand, NiChanges> NiChangesPerBand;
 
+  /**
+   * Noise and interference change as seen by the SNIR and PER computations,
+   * also used as the element of the flat timeline.
+   */
+  struct NiChangeEntry
+  {
+    Time time;         //!< time of the change
+    double power;      //!< noise and interference power from this time on, in watts
+    uint64_t eventUid; //!< unique identifier of the event causing the change (0 if none)
+  };
+
+  /**
+   * Flat timeline of the noise and interference changes of a given band.
+   * Entries are sorted by time; those before m_head have been pruned and
+   * the entry at m_head is always a zero power change at time 0.
+   */
+  struct FlatNiChanges
+  {
+    std::vector<NiChangeEntry> m_entries; //!< time-ordered NI changes
+    std::size_t m_head;                   //!< index of the first valid entry
+    double m_firstPower;                  //!< first power of the band in watts
+  };
+
+  /**
+   * Contiguous view over the NI changes spanning an event, i.e. from the
+   * change at the start of the event to the change at the end of the event
+   * (both included), without the other changes caused by the event.
+   */
+  struct NiChangesSpan
+  {
+    const NiChangeEntry *begin; //!< change at the start of the event
+    const NiChangeEntry *end;   //!< one past the change at the end of the event
+    double firstPower;          //!< noise and interference power at the start of the reception, in watts
+  };
+
   /**
    * Append the given Event.
    *
@@ -368,55 +438,56 @@ private:
    * Calculate noise and interference power in W.
    *
    * \param event the event
-   * \param nis the NiChanges
+   * \param nis the NI changes spanning the event, to be filled in
    * \param band the band
    *
    * \return noise and interference power
    */
-  double CalculateNoiseInterferenceW (Ptr<Event> event, NiChangesPerBand *nis, WifiSpectrumBand band) const;
+  double CalculateNoiseInterferenceW (Ptr<Event> event, NiChangesSpan *nis, WifiSpectrumBand band) const;
   /**
    * Calculate the error rate of the given PHY payload only in the provided time
    * window (thus enabling per MPDU PER information). The PHY payload can be divided into
-   * multiple chunks (e.g. due to interference from other transmissions).
+   * multiple chunks (e.g. due to interference from other transmissions), whose success
+   * rates are computed by a single call to ErrorRateModel::GetChunkSuccessRates.
    *
    * \param event the event
    * \param channelWidth the channel width used to transmit the PSDU (in MHz)
-   * \param nis the NiChanges
+   * \param nis the NI changes spanning the event
    * \param band identify the band used by the PSDU
    * \param staId the station ID of the PSDU (only used for MU)
    * \param window time window (pair of start and end times) of PHY payload to focus on
    *
    * \return the error rate of the payload
    */
-  double CalculatePayloadPer (Ptr<const Event> event, uint16_t channelWidth, NiChangesPerBand *nis, WifiSpectrumBand band,
+  double CalculatePayloadPer (Ptr<const Event> event, uint16_t channelWidth, const NiChangesSpan &nis, WifiSpectrumBand band,
                               uint16_t staId, std::pair<Time, Time> window) const;
   /**
    * Calculate the error rate of the PHY header. The PHY header
    * can be divided into multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event the event
-   * \param nis the NiChanges
+   * \param nis the NI changes spanning the event
    * \param channelWidth the channel width (in MHz) for header measurement
    * \param band the band
    * \param header the PHY header to consider
    *
    * \return the error rate of the HT PHY header
    */
-  double CalculatePhyHeaderPer (Ptr<const Event> event, NiChangesPerBand *nis,
+  double CalculatePhyHeaderPer (Ptr<const Event> event, const NiChangesSpan &nis,
                                 uint16_t channelWidth, WifiSpectrumBand band,
                                 WifiPpduField header) const;
   /**
    * Calculate the success rate of the PHY header sections for the provided event.
    *
    * \param event the event
-   * \param nis the NiChanges
+   * \param nis the NI changes spanning the event
    * \param channelWidth the channel width (in MHz) for header measurement
    * \param band the band
    * \param phyHeaderSections the map of PHY header sections (\see PhyEntity::PhyHeaderSections)
    *
    * \return the success rate of the PHY header sections
    */
-  double CalculatePhyHeaderSectionPsr (Ptr<const Event> event, NiChangesPerBand *nis,
+  double CalculatePhyHeaderSectionPsr (Ptr<const Event> event, const NiChangesSpan &nis,
                                        uint16_t channelWidth, WifiSpectrumBand band,
                                        PhyEntity::PhyHeaderSections phyHeaderSections) const;
 
@@ -426,6 +497,14 @@ private:
   NiChangesPerBand m_niChangesPerBand;                     //!< NI Changes for each band
   std::map <WifiSpectrumBand, double> m_firstPowerPerBand; //!< first power of each band in watts
   bool m_rxing;                                            //!< flag whether it is in receiving state
+  TimelineType m_timelineType;                             //!< storage used to record NI changes
+  std::vector<WifiSpectrumBand> m_bands;                   //!< bands in the order they have been added
+  std::map <WifiSpectrumBand, std::size_t> m_bandIds;      //!< ID of each band in the flat timeline
+  std::vector<FlatNiChanges> m_flatNiChanges;              //!< flat timeline of NI changes, indexed by band ID
+  mutable std::vector<NiChangeEntry> m_niChangesScratch;   //!< NI changes spanning an event (multimap timeline only)
+  mutable std::vector<double> m_chunkSnrs;                 //!< SNRs of the payload chunks of an event
+  mutable std::vector<uint64_t> m_chunkBits;               //!< number of bits of the payload chunks of an event
+  mutable std::vector<double> m_chunkSuccessRates;         //!< success rates of the payload chunks of an event
 
   /**
    * Returns an iterator to the first NiChange that is later than moment
@@ -454,6 +533,51 @@ private:
    * \returns the iterator of the new event
    */
   NiChanges::iterator AddNiChangeEvent (Time moment, NiChange change, WifiSpectrumBand band);
+
+  /**
+   * Return the flat timeline of NI changes of a given band.
+   *
+   * \param band identify the band
+   * \returns the flat timeline of the band
+   */
+  FlatNiChanges& GetFlatNiChanges (WifiSpectrumBand band);
+  /**
+   * \copydoc GetFlatNiChanges
+   */
+  const FlatNiChanges& GetFlatNiChanges (WifiSpectrumBand band) const;
+  /**
+   * Returns the index of the first NI change that is later than moment
+   * in the given flat timeline.
+   *
+   * \param moment time to check from
+   * \param nis the flat timeline
+   * \returns the index of the first NI change that is later than moment
+   */
+  static std::size_t GetNextIndex (Time moment, const FlatNiChanges &nis);
+  /**
+   * Returns the index of the last NI change that is not later than moment
+   * in the given flat timeline.
+   *
+   * \param moment time to check from
+   * \param nis the flat timeline
+   * \returns the index of the last NI change that is not later than moment
+   */
+  static std::size_t GetPreviousIndex (Time moment, const FlatNiChanges &nis);
+  /**
+   * Insert a NI change in the given flat timeline after all the changes
+   * occurring at the same time.
+   *
+   * \param change the NI change to insert
+   * \param nis the flat timeline
+   * \returns the index of the inserted NI change
+   */
+  static std::size_t AddFlatNiChange (const NiChangeEntry &change, FlatNiChanges *nis);
+  /**
+   * Reset the given flat timeline, leaving only the zero power change at time 0.
+   *
+   * \param nis the flat timeline
+   */
+  static void ResetFlatNiChanges (FlatNiChanges *nis);
 };
 
 } //namespace ns3
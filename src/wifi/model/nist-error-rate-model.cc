@@ -21,6 +21,7 @@
 
 #include <cmath>
 #include <bitset>
+#include <algorithm>
 #include "ns3/log.h"
 #include "nist-error-rate-model.h"
 #include "wifi-tx-vector.h"
@@ -31,6 +32,36 @@ NS_LOG_COMPONENT_DEFINE ("NistErrorRateModel");
 
 NS_OBJECT_ENSURE_REGISTERED (NistErrorRateModel);
 
+namespace {
+
+/**
+ * The coded BER of a code rate, i.e., factor * sum_k (coeffs[k] * D^(first + k * step)),
+ * as used by NistErrorRateModel::CalculatePe.
+ */
+struct NistPePolynomial
+{
+  double factor;        //!< the factor of the sum
+  unsigned int first;   //!< the exponent of the first term
+  unsigned int step;    //!< the difference between the exponents of consecutive terms
+  std::size_t size;     //!< the number of terms
+  double coeffs[10];    //!< the coefficients of the terms
+};
+
+/// Code rate 1/2, table 3.1.1
+const NistPePolynomial g_nistPe12 = {0.5, 10, 2, 9, {36.0, 211.0, 1404.0, 11633.0, 77433.0, 502690.0, 3322763.0,
+                                                       21292910.0, 134365911.0}};
+/// Code rate 2/3, table 3.1.2
+const NistPePolynomial g_nistPe23 = {1.0 / 4.0, 6, 1, 10, {3.0, 70.0, 285.0, 1276.0, 6160.0, 27128.0, 117019.0,
+                                                             498860.0, 2103891.0, 8784123.0}};
+/// Code rate 3/4, table 3.1.2
+const NistPePolynomial g_nistPe34 = {1.0 / 6.0, 5, 1, 10, {42.0, 201.0, 1492.0, 10469.0, 62935.0, 379644.0,
+                                                             2253373.0, 13073811.0, 75152755.0, 428005675.0}};
+/// Code rate 5/6, table V from D. Haccoun and G. Begin
+const NistPePolynomial g_nistPe56 = {1.0 / 10.0, 4, 1, 10, {92.0, 528.0, 8694.0, 79453.0, 792114.0, 7375573.0,
+                                                              67884974.0, 610875423.0, 5427275376.0, 47664215639.0}};
+
+} // unnamed namespace
+
 TypeId
 NistErrorRateModel::GetTypeId (void)
 {
@@ -242,4 +273,77 @@ NistErrorRateModel::DoGetChunkSuccessRate (WifiMode mode, const WifiTxVector& tx
   return 0;
 }
 
+void
+NistErrorRateModel::DoGetChunkSuccessRates (WifiMode mode, const WifiTxVector& txVector, const std::vector<double>& snrs,
+                                            const std::vector<uint64_t>& nbits, std::vector<double>& successRates,
+                                            uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const
+{
+  NS_LOG_FUNCTION (this << mode << snrs.size () << +numRxAntennas << field << staId);
+  if (mode.GetModulationClass () != WIFI_MOD_CLASS_ERP_OFDM
+      && mode.GetModulationClass () != WIFI_MOD_CLASS_OFDM
+      && mode.GetModulationClass () != WIFI_MOD_CLASS_HT
+      && mode.GetModulationClass () != WIFI_MOD_CLASS_VHT
+      && mode.GetModulationClass () != WIFI_MOD_CLASS_HE)
+    {
+      std::fill (successRates.begin (), successRates.end (), 0.0);
+      return;
+    }
+
+  // the uncoded BER is berFactor * erfc (sqrt (snr / snrDivisor)), the
+  // operations being the same as the ones of GetBpskBer, GetQpskBer and
+  // GetQamBer so that the BERs are identical
+  uint16_t constellationSize = mode.GetConstellationSize ();
+  double berFactor = 0.5;
+  double snrDivisor = 1.0;
+  if (constellationSize == 4)
+    {
+      snrDivisor = 2.0;
+    }
+  else if (constellationSize > 4)
+    {
+      NS_ASSERT (std::bitset<16> (constellationSize).count () == 1); //constellationSize has to be a power of 2
+      snrDivisor = (2 * (constellationSize - 1)) / 3;
+      uint8_t bitsPerSymbol = std::sqrt (constellationSize);
+      berFactor = (bitsPerSymbol - 1) / (bitsPerSymbol * std::log2 (bitsPerSymbol));
+    }
+
+  const NistPePolynomial *poly = nullptr;
+  switch (GetBValue (mode.GetCodeRate ()))
+    {
+    case 1:
+      poly = &g_nistPe12;
+      break;
+    case 2:
+      poly = &g_nistPe23;
+      break;
+    case 3:
+      poly = &g_nistPe34;
+      break;
+    default:
+      poly = &g_nistPe56;
+      break;
+    }
+
+  for (std::size_t i = 0; i < snrs.size (); i++)
+    {
+      double ber = berFactor * erfc (std::sqrt (snrs[i] / snrDivisor));
+      double d = std::sqrt (4.0 * ber * (1.0 - ber));
+      double x = (poly->step == 1) ? d : d * d;
+      double sum = poly->coeffs[poly->size - 1];
+      for (std::size_t k = poly->size - 1; k > 0; k--)
+        {
+          sum = sum * x + poly->coeffs[k - 1];
+        }
+      double dFirst = 1.0;
+      for (unsigned int k = 0; k < poly->first; k++)
+        {
+          dFirst *= d;
+        }
+      double pe = std::min (poly->factor * dFirst * sum, 1.0);
+      // (1 - pe)^nbits, with log1p preserving the accuracy of small pe
+      double successRate = (nbits[i] == 0) ? 1.0 : std::exp (nbits[i] * std::log1p (-pe));
+      successRates[i] = (ber == 0.0) ? 1.0 : successRate;
+    }
+}
+
 } //namespace ns3
@@ -33,6 +33,14 @@ namespace ns3 {
  * the model description and validation can be found in
  * http://www.nsnam.org/~pei/80211ofdm.pdf.  For DSSS modulations (802.11b),
  * the model uses the DsssErrorRateModel.
+ *
+ * The success rates of a batch of chunks (see GetChunkSuccessRates) are
+ * computed by evaluating the coded BER polynomials with Horner's scheme and
+ * the success rate of each chunk in the log domain, rather than through
+ * repeated calls to std::pow. These success rates are not bit-identical to
+ * the ones returned for a single chunk: the absolute difference is less
+ * than 1e-15 per bit of the chunk (the rounding of 1 - pe being raised to
+ * the number of bits by std::pow).
  */
 class NistErrorRateModel : public ErrorRateModel
 {
@@ -49,6 +57,9 @@ public:
 private:
   double DoGetChunkSuccessRate (WifiMode mode, const WifiTxVector& txVector, double snr, uint64_t nbits,
                                 uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const override;
+  void DoGetChunkSuccessRates (WifiMode mode, const WifiTxVector& txVector, const std::vector<double>& snrs,
+                               const std::vector<uint64_t>& nbits, std::vector<double>& successRates,
+                               uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const override;
   /**
    * Return the bValue such that coding rate = bValue / (bValue + 1).
    *
@@ -69,7 +69,7 @@ std::ostream & operator << (std::ostream &os, const PhyEntity::PhyFieldRxStatus
  *       Abstract base class for PHY entities
  *******************************************************/
 
-uint64_t PhyEntity::m_globalPpduUid = 0;
+thread_local uint64_t PhyEntity::m_globalPpduUid = 0;
 
 PhyEntity::~PhyEntity ()
 {
@@ -359,7 +359,7 @@ PhyEntity::DoEndReceiveField (WifiPpduField field, Ptr<Event> event)
 }
 
 void
-PhyEntity::StartReceivePreamble (Ptr<WifiPpdu> ppdu, RxPowerWattPerChannelBand rxPowersW,
+PhyEntity::StartReceivePreamble (Ptr<const WifiPpdu> ppdu, RxPowerWattPerChannelBand rxPowersW,
                                  Time /* rxDuration */)
 {
   //The total RX power corresponds to the maximum over all the bands
@@ -1021,7 +1021,13 @@ uint64_t
 PhyEntity::ObtainNextUid (const WifiTxVector& /* txVector */)
 {
   NS_LOG_FUNCTION (this);
-  return m_globalPpduUid++;
+  return ObtainNextGlobalUid ();
+}
+
+uint64_t
+PhyEntity::ObtainNextGlobalUid (void)
+{
+  return (static_cast<uint64_t> (Simulator::GetSystemId ()) << 48) | m_globalPpduUid++;
 }
 
 uint16_t
@@ -1084,7 +1090,7 @@ PhyEntity::CalculateTxDuration (WifiConstPsduMap psduMap, const WifiTxVector& tx
 }
 
 bool
-PhyEntity::CanReceivePpdu (Ptr<WifiPpdu> ppdu, uint16_t txCenterFreq) const
+PhyEntity::CanReceivePpdu (Ptr<const WifiPpdu> ppdu, uint16_t txCenterFreq) const
 {
   NS_LOG_FUNCTION (this << ppdu << txCenterFreq);
 
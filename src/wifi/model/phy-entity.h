@@ -358,7 +358,7 @@ public:
    * \param rxPowersW the receive power in W per band
    * \param rxDuration the duration of the PPDU
    */
-  virtual void StartReceivePreamble (Ptr<WifiPpdu> ppdu, RxPowerWattPerChannelBand rxPowersW,
+  virtual void StartReceivePreamble (Ptr<const WifiPpdu> ppdu, RxPowerWattPerChannelBand rxPowersW,
                                      Time rxDuration);
   /**
    * Start receiving a given field.
@@ -488,7 +488,7 @@ public:
    *        PPDU is transmitted
    * \return true if this PPDU can be received, false otherwise
    */
-  virtual bool CanReceivePpdu (Ptr<WifiPpdu> ppdu, uint16_t txCenterFreq) const;
+  virtual bool CanReceivePpdu (Ptr<const WifiPpdu> ppdu, uint16_t txCenterFreq) const;
 
 protected:
   /**
@@ -762,6 +762,14 @@ protected:
    * \return the UID to use for the PPDU to transmit
    */
   virtual uint64_t ObtainNextUid (const WifiTxVector& txVector);
+  /**
+   * Increment the global UID counter. The counter is kept per thread and
+   * the system id is stored in the upper bits of the UID, so that the
+   * UIDs are unique in a multithreaded simulation.
+   *
+   * \return the next global UID
+   */
+  static uint64_t ObtainNextGlobalUid (void);
 
   /**
    * \param txPowerW power in W to spread across the bands
@@ -819,7 +827,7 @@ protected:
   std::map<UidStaIdPair, std::vector<bool> > m_statusPerMpduMap; //!< Map of the current reception status per MPDU that is filled in as long as MPDUs are being processed by the PHY in case of an A-MPDU
   std::map<UidStaIdPair, SignalNoiseDbm> m_signalNoiseMap; //!< Map of the latest signal power and noise power in dBm (noise power includes the noise figure)
 
-  static uint64_t m_globalPpduUid; //!< Global counter of the PPDU UID
+  static thread_local uint64_t m_globalPpduUid; //!< Global counter of the PPDU UID, per thread
 }; //class PhyEntity
 
 /**
@@ -146,10 +146,12 @@ SpectrumWifiPhy::UpdateInterferenceHelperBands (void)
   NS_LOG_FUNCTION (this);
   uint16_t channelWidth = GetChannelWidth ();
   m_interference.RemoveBands ();
+  m_rxFilterBands.clear ();
   if (channelWidth < 20)
     {
       WifiSpectrumBand band = GetBand (channelWidth);
       m_interference.AddBand (band);
+      m_rxFilterBands.push_back ({channelWidth, band});
     }
   else
     {
@@ -157,7 +159,9 @@ SpectrumWifiPhy::UpdateInterferenceHelperBands (void)
         {
           for (uint8_t i = 0; i < (channelWidth / bw); ++i)
             {
-              m_interference.AddBand (GetBand (bw, i));
+              WifiSpectrumBand band = GetBand (bw, i);
+              m_interference.AddBand (band);
+              m_rxFilterBands.push_back ({bw, band});
             }
         }
     }
@@ -274,72 +278,62 @@ SpectrumWifiPhy::StartRx (Ptr<SpectrumSignalParameters> rxParams)
 {
   NS_LOG_FUNCTION (this << rxParams);
   Time rxDuration = rxParams->duration;
-  Ptr<SpectrumValue> receivedSignalPsd = rxParams->psd;
-  NS_LOG_DEBUG ("Received signal with PSD " << *receivedSignalPsd << " and duration " << rxDuration.As (Time::NS));
+  // The received PSD is either carried by the signal or shared with the other
+  // receivers, in which case it has to be scaled by the gain of the channel
+  Ptr<const SpectrumValue> receivedSignalPsd = rxParams->psd;
+  double psdGain = 1.0;
+  if (!receivedSignalPsd)
+    {
+      NS_ASSERT (rxParams->sharedPsd);
+      receivedSignalPsd = rxParams->sharedPsd;
+      psdGain = rxParams->sharedPsdGain;
+    }
+  NS_LOG_DEBUG ("Received signal with PSD " << *receivedSignalPsd << " (gain " << psdGain << ") and duration " << rxDuration.As (Time::NS));
   uint32_t senderNodeId = 0;
   if (rxParams->txPhy)
     {
       senderNodeId = rxParams->txPhy->GetDevice ()->GetNode ()->GetId ();
     }
-  NS_LOG_DEBUG ("Received signal from " << senderNodeId << " with unfiltered power " << WToDbm (Integral (*receivedSignalPsd)) << " dBm");
+  NS_LOG_DEBUG ("Received signal from " << senderNodeId << " with unfiltered power " << WToDbm (Integral (*receivedSignalPsd) * psdGain) << " dBm");
 
   // Integrate over our receive bandwidth (i.e., all that the receive
   // spectral mask representing our filtering allows) to find the
   // total energy apparent to the "demodulator".
-  // This is done per 20 MHz channel band.
+  // This is done per 20 MHz channel band. The RF filters of the bands
+  // only depend on the current channel, hence the received power is
+  // directly summed over the subbands of each band of the channel.
   uint16_t channelWidth = GetChannelWidth ();
   double totalRxPowerW = 0;
+  double rxGain = DbToRatio (GetRxGain ());
   RxPowerWattPerChannelBand rxPowerW;
 
-  if ((channelWidth == 5) || (channelWidth == 10))
-    {
-      WifiSpectrumBand filteredBand = GetBand (channelWidth);
-      Ptr<SpectrumValue> filter = WifiSpectrumValueHelper::CreateRfFilter (GetFrequency (), channelWidth, GetBandBandwidth (), GetGuardBandwidth (channelWidth), filteredBand);
-      SpectrumValue filteredSignal = (*filter) * (*receivedSignalPsd);
-      NS_LOG_DEBUG ("Signal power received (watts) before antenna gain: " << Integral (filteredSignal));
-      double rxPowerPerBandW = Integral (filteredSignal) * DbToRatio (GetRxGain ());
-      totalRxPowerW += rxPowerPerBandW;
-      rxPowerW.insert ({filteredBand, rxPowerPerBandW});
-      NS_LOG_DEBUG ("Signal power received after antenna gain for " << channelWidth << " MHz channel: " << rxPowerPerBandW << " W (" << WToDbm (rxPowerPerBandW) << " dBm)");
-    }
-
-  for (uint16_t bw = 160; bw > 20; bw = bw / 2) //20 MHz is handled apart since the totalRxPowerW is computed through it
+  GetRxSpectrumModel (); //creates the spectrum model and the channel bands if not done yet
+  NS_ASSERT (!m_rxFilterBands.empty ());
+  for (const auto& bwBandPair : m_rxFilterBands)
     {
-      for (uint8_t i = 0; i < (channelWidth / bw); i++)
+      double rxPowerPerBandW = WifiSpectrumValueHelper::GetBandPowerW (receivedSignalPsd, bwBandPair.second, psdGain);
+      NS_LOG_DEBUG ("Signal power received (watts) before antenna gain for " << bwBandPair.first << " MHz channel band ("
+                    << bwBandPair.second.first << "; " << bwBandPair.second.second << "): " << rxPowerPerBandW);
+      rxPowerPerBandW *= rxGain;
+      if (bwBandPair.first <= 20)
         {
-          NS_ASSERT (channelWidth >= bw);
-          WifiSpectrumBand filteredBand = GetBand (bw, i);
-          Ptr<SpectrumValue> filter = WifiSpectrumValueHelper::CreateRfFilter (GetFrequency (), channelWidth, GetBandBandwidth (), GetGuardBandwidth (channelWidth), filteredBand);
-          SpectrumValue filteredSignal = (*filter) * (*receivedSignalPsd);
-          NS_LOG_DEBUG ("Signal power received (watts) before antenna gain for " << bw << " MHz channel band " << +i << ": " << Integral (filteredSignal));
-          double rxPowerPerBandW = Integral (filteredSignal) * DbToRatio (GetRxGain ());
-          rxPowerW.insert ({filteredBand, rxPowerPerBandW});
-          NS_LOG_DEBUG ("Signal power received after antenna gain for " << bw << " MHz channel band " << +i << ": " << rxPowerPerBandW << " W (" << WToDbm (rxPowerPerBandW) << " dBm)");
+          //the total power is computed through the 20 MHz (or narrower) channel bands
+          totalRxPowerW += rxPowerPerBandW;
         }
+      rxPowerW.insert ({bwBandPair.second, rxPowerPerBandW});
+      NS_LOG_DEBUG ("Signal power received after antenna gain for " << bwBandPair.first << " MHz channel band ("
+                    << bwBandPair.second.first << "; " << bwBandPair.second.second << "): " << rxPowerPerBandW << " W (" << WToDbm (rxPowerPerBandW) << " dBm)");
     }
 
-
-  for (uint8_t i = 0; i < (channelWidth / 20); i++)
-    {
-      WifiSpectrumBand filteredBand = GetBand (20, i);
-      Ptr<SpectrumValue> filter = WifiSpectrumValueHelper::CreateRfFilter (GetFrequency (), channelWidth, GetBandBandwidth (), GetGuardBandwidth (channelWidth), filteredBand);
-      SpectrumValue filteredSignal = (*filter) * (*receivedSignalPsd);
-      NS_LOG_DEBUG ("Signal power received (watts) before antenna gain for 20 MHz channel band " << +i << ": " << Integral (filteredSignal));
-      double rxPowerPerBandW = Integral (filteredSignal) * DbToRatio (GetRxGain ());
-      totalRxPowerW += rxPowerPerBandW;
-      rxPowerW.insert ({filteredBand, rxPowerPerBandW});
-      NS_LOG_DEBUG ("Signal power received after antenna gain for 20 MHz channel band " << +i << ": " << rxPowerPerBandW << " W (" << WToDbm (rxPowerPerBandW) << " dBm)");
-    }
-  
   if (GetPhyStandard () >= WIFI_PHY_STANDARD_80211ax)
     {
-      NS_ASSERT (!m_ruBands[channelWidth].empty ());
-      for (const auto& bandRuPair : m_ruBands[channelWidth])
+      const RuBand& ruBands = m_ruBands[channelWidth];
+      NS_ASSERT (!ruBands.empty ());
+      for (const auto& bandRuPair : ruBands)
         {
-          Ptr<SpectrumValue> filter = WifiSpectrumValueHelper::CreateRfFilter (GetFrequency (), channelWidth, GetBandBandwidth (), GetGuardBandwidth (channelWidth), bandRuPair.first);
-          SpectrumValue filteredSignal = (*filter) * (*receivedSignalPsd);
-          NS_LOG_DEBUG ("Signal power received (watts) before antenna gain for RU with type " << bandRuPair.second.ruType << " and index " << bandRuPair.second.index << " -> (" << bandRuPair.first.first << "; " << bandRuPair.first.second <<  "): " << Integral (filteredSignal));
-          double rxPowerPerBandW = Integral (filteredSignal) * DbToRatio (GetRxGain ());
+          double rxPowerPerBandW = WifiSpectrumValueHelper::GetBandPowerW (receivedSignalPsd, bandRuPair.first, psdGain);
+          NS_LOG_DEBUG ("Signal power received (watts) before antenna gain for RU with type " << bandRuPair.second.ruType << " and index " << bandRuPair.second.index << " -> (" << bandRuPair.first.first << "; " << bandRuPair.first.second <<  "): " << rxPowerPerBandW);
+          rxPowerPerBandW *= rxGain;
           NS_LOG_DEBUG ("Signal power received after antenna gain for RU with type " << bandRuPair.second.ruType << " and index " << bandRuPair.second.index << " -> (" << bandRuPair.first.first << "; " << bandRuPair.first.second <<  "): " << rxPowerPerBandW << " W (" << WToDbm (rxPowerPerBandW) << " dBm)");
           rxPowerW.insert ({bandRuPair.first, rxPowerPerBandW});
         }
@@ -397,8 +391,7 @@ SpectrumWifiPhy::StartRx (Ptr<SpectrumSignalParameters> rxParams)
     }
 
   NS_LOG_INFO ("Received Wi-Fi signal");
-  Ptr<WifiPpdu> ppdu = wifiRxParams->ppdu->Copy ();
-  StartReceivePreamble (ppdu, rxPowerW, rxDuration);
+  StartReceivePreamble (wifiRxParams->ppdu, rxPowerW, rxDuration);
 }
 
 Ptr<AntennaModel>
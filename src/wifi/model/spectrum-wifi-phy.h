@@ -183,7 +183,8 @@ private:
    */
   void ResetSpectrumModel (void);
   /**
-   * This function is called to update the bands handled by the InterferenceHelper.
+   * This function is called to update the bands handled by the InterferenceHelper,
+   * as well as the bands over which the received power is integrated.
    */
   void UpdateInterferenceHelperBands (void);
 
@@ -198,6 +199,14 @@ private:
 
   std::map<uint16_t, RuBand> m_ruBands;  /**< For each channel width, store all the distinct spectrum
                                               bands associated with every RU in a channel of that width */
+
+  /**
+   * The bands of the current channel over which the received power is
+   * integrated (i.e. the RF filters applied upon reception), along with
+   * their width (MHz), in the order they are processed. RU bands are
+   * found in m_ruBands.
+   */
+  std::vector<std::pair<uint16_t, WifiSpectrumBand>> m_rxFilterBands;
   bool m_disableWifiReception;                              //!< forces this PHY to fail to sync on any signal
   TracedCallback<bool, uint32_t, double, Time> m_signalCb;  //!< Signal callback
 
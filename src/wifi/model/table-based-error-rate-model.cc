@@ -64,6 +64,10 @@ TableBasedErrorRateModel::GetTypeId (void)
 TableBasedErrorRateModel::TableBasedErrorRateModel ()
 {
   NS_LOG_FUNCTION (this);
+  // build the lookups of the reference tables if not done yet
+  GetLookups (false, false);
+  GetLookups (false, true);
+  GetLookups (true, false);
 }
 
 TableBasedErrorRateModel::~TableBasedErrorRateModel ()
@@ -140,85 +144,160 @@ TableBasedErrorRateModel::GetMcsForMode (WifiMode mode)
   return mcs;
 }
 
+uint8_t
+TableBasedErrorRateModel::GetTableMcs (WifiMode mode, bool ldpc) const
+{
+  uint8_t mcs = GetMcsForMode (mode);
+  // HT: for mcs greater than 7, use 0 - 7 curves for data rate
+  if (mode.GetModulationClass () == WIFI_MOD_CLASS_HT)
+    {
+      mcs = mcs % 8;
+    }
+  if (mcs > (ldpc ? ERROR_TABLE_LDPC_MAX_NUM_MCS : ERROR_TABLE_BCC_MAX_NUM_MCS))
+    {
+      return 0xff;
+    }
+  return mcs;
+}
+
 double
-TableBasedErrorRateModel::DoGetChunkSuccessRate (WifiMode mode, const WifiTxVector& txVector, double snr, uint64_t nbits, uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const
+TableBasedErrorRateModel::GetTablePer (uint8_t mcs, bool ldpc, double snr, uint64_t nbits) const
 {
-  NS_LOG_FUNCTION (this << mode << txVector << snr << nbits << +numRxAntennas << field << staId);
   uint64_t size = std::max<uint64_t> (1, (nbits / 8));
   double roundedSnr = RoundSnr (RatioToDb (snr), SNR_PRECISION);
-  uint8_t mcs = GetMcsForMode (mode);
-  bool ldpc = txVector.IsLdpc ();
   NS_LOG_FUNCTION (this << +mcs << roundedSnr << size << ldpc);
 
-  // HT: for mcs greater than 7, use 0 - 7 curves for data rate
-  if (mode.GetModulationClass () == WIFI_MOD_CLASS_HT)
+  bool smallFrames = !ldpc && size < m_threshold;
+  double per = GetLookups (ldpc, smallFrames)[mcs].GetPer (roundedSnr);
+
+  uint16_t tableSize = (ldpc ? ERROR_TABLE_LDPC_FRAME_SIZE : (smallFrames ? ERROR_TABLE_BCC_SMALL_FRAME_SIZE : ERROR_TABLE_BCC_LARGE_FRAME_SIZE));
+  if (size != tableSize && per > 0 && per < 1)
     {
-      mcs = mcs % 8;
+      // From IEEE document 11-14/0803r1 (Packet Length for Box 0 Calibration)
+      per = (1.0 - std::pow ((1 - per), (static_cast<double> (size) / tableSize)));
     }
 
-  if (mcs > (ldpc ? ERROR_TABLE_LDPC_MAX_NUM_MCS : ERROR_TABLE_BCC_MAX_NUM_MCS))
+  if (per < TABLED_BASED_ERROR_MODEL_PRECISION)
+    {
+      per = 0.0;
+    }
+  return per;
+}
+
+double
+TableBasedErrorRateModel::DoGetChunkSuccessRate (WifiMode mode, const WifiTxVector& txVector, double snr, uint64_t nbits, uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const
+{
+  NS_LOG_FUNCTION (this << mode << txVector << snr << nbits << +numRxAntennas << field << staId);
+  bool ldpc = txVector.IsLdpc ();
+  uint8_t mcs = GetTableMcs (mode, ldpc);
+  if (mcs == 0xff)
     {
-      NS_LOG_WARN ("Table missing for MCS: " << +mcs << " in TableBasedErrorRateModel: use fallback error rate model");
+      NS_LOG_WARN ("Table missing for MCS: " << +GetMcsForMode (mode) << " in TableBasedErrorRateModel: use fallback error rate model");
       return m_fallbackErrorModel->GetChunkSuccessRate (mode, txVector, snr, nbits, staId);
     }
+  return 1.0 - GetTablePer (mcs, ldpc, snr, nbits);
+}
 
-  auto errorTable = (ldpc ? AwgnErrorTableLdpc1458 : (size < m_threshold ? AwgnErrorTableBcc32 : AwgnErrorTableBcc1458));
-  auto itVector = errorTable[mcs];
-  auto itTable = std::find_if (itVector.begin(), itVector.end(),
-      [&roundedSnr](const std::pair<double, double>& element) {
-          return element.first == roundedSnr;
-      });
-  double minSnr = itVector.begin ()->first;
-  double maxSnr = (--itVector.end ())->first;
-  double per;
-  if (itTable == itVector.end ())
+void
+TableBasedErrorRateModel::DoGetChunkSuccessRates (WifiMode mode, const WifiTxVector& txVector, const std::vector<double>& snrs,
+                                                  const std::vector<uint64_t>& nbits, std::vector<double>& successRates,
+                                                  uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const
+{
+  NS_LOG_FUNCTION (this << mode << txVector << snrs.size () << +numRxAntennas << field << staId);
+  bool ldpc = txVector.IsLdpc ();
+  uint8_t mcs = GetTableMcs (mode, ldpc);
+  if (mcs == 0xff)
     {
-      if (roundedSnr < minSnr)
+      NS_LOG_WARN ("Table missing for MCS: " << +GetMcsForMode (mode) << " in TableBasedErrorRateModel: use fallback error rate model");
+      for (std::size_t i = 0; i < snrs.size (); i++)
         {
-          per = 1.0;
+          successRates[i] = m_fallbackErrorModel->GetChunkSuccessRate (mode, txVector, snrs[i], nbits[i], staId);
         }
-      else if (roundedSnr > maxSnr)
-        {
-          per = 0.0;
-        }
-      else
+      return;
+    }
+  for (std::size_t i = 0; i < snrs.size (); i++)
+    {
+      successRates[i] = 1.0 - GetTablePer (mcs, ldpc, snrs[i], nbits[i]);
+    }
+}
+
+const std::vector<SnrPerTableLookup> &
+TableBasedErrorRateModel::GetLookups (bool ldpc, bool smallFrames)
+{
+  static const std::vector<SnrPerTableLookup> bcc32 (AwgnErrorTableBcc32,
+                                                     AwgnErrorTableBcc32 + ERROR_TABLE_BCC_MAX_NUM_MCS + 1);
+  static const std::vector<SnrPerTableLookup> bcc1458 (AwgnErrorTableBcc1458,
+                                                       AwgnErrorTableBcc1458 + ERROR_TABLE_BCC_MAX_NUM_MCS + 1);
+  static const std::vector<SnrPerTableLookup> ldpc1458 (AwgnErrorTableLdpc1458,
+                                                        AwgnErrorTableLdpc1458 + ERROR_TABLE_LDPC_MAX_NUM_MCS + 1);
+  return (ldpc ? ldpc1458 : (smallFrames ? bcc32 : bcc1458));
+}
+
+SnrPerTableLookup::SnrPerTableLookup (const SnrPerTable &table)
+  : m_step (0)
+{
+  NS_ASSERT (!table.empty ());
+  for (const auto & snrPer : table)
+    {
+      NS_ASSERT (m_snrs.empty () || snrPer.first > m_snrs.back ());
+      m_snrs.push_back (snrPer.first);
+      m_pers.push_back (snrPer.second);
+    }
+  m_minSnr = m_snrs.front ();
+  m_maxSnr = m_snrs.back ();
+  if (m_snrs.size () > 1)
+    {
+      double step = (m_maxSnr - m_minSnr) / (m_snrs.size () - 1);
+      bool uniform = true;
+      for (std::size_t i = 0; i < m_snrs.size (); i++)
         {
-          double a = 0.0, b = 0.0, previousSnr = 0.0, nextSnr = 0.0;
-          for (auto i = itVector.begin (); i != itVector.end (); ++i)
+          if (std::abs (m_snrs[i] - (m_minSnr + i * step)) > step * 1e-6)
             {
-              if (i->first < roundedSnr)
-                {
-                  previousSnr = i->first;
-                  a = i->second;
-                }
-              else
-                {
-                  nextSnr = i->first;
-                  b = i->second;
-                  break;
-                }
+              uniform = false;
+              break;
             }
-          per = a + (roundedSnr - previousSnr) * (b - a) / (nextSnr - previousSnr);
         }
+      m_step = (uniform ? step : 0);
     }
-  else
+}
+
+double
+SnrPerTableLookup::GetPer (double snr) const
+{
+  if (snr < m_minSnr)
     {
-      per = itTable->second;
+      return 1.0;
     }
-
-  uint16_t tableSize = (ldpc ? ERROR_TABLE_LDPC_FRAME_SIZE : (size < m_threshold ? ERROR_TABLE_BCC_SMALL_FRAME_SIZE : ERROR_TABLE_BCC_LARGE_FRAME_SIZE));
-  if (size != tableSize)
+  if (snr > m_maxSnr)
     {
-      // From IEEE document 11-14/0803r1 (Packet Length for Box 0 Calibration)
-      per = (1.0 - std::pow ((1 - per), (static_cast<double> (size) / tableSize)));
+      return 0.0;
     }
-
-  if (per < TABLED_BASED_ERROR_MODEL_PRECISION)
+  // find the index i of the largest SNR that is lower than or equal to snr
+  std::size_t i;
+  if (m_step > 0)
     {
-      per = 0.0;
+      i = std::min<std::size_t> (static_cast<std::size_t> ((snr - m_minSnr) / m_step), m_snrs.size () - 1);
+      // the computed index may be off by one because of rounding errors
+      if (m_snrs[i] > snr)
+        {
+          i--;
+        }
+      else if (i + 1 < m_snrs.size () && m_snrs[i + 1] <= snr)
+        {
+          i++;
+        }
     }
-
-  return 1.0 - per;
+  else
+    {
+      i = std::upper_bound (m_snrs.begin (), m_snrs.end (), snr) - m_snrs.begin () - 1;
+    }
+  if (m_snrs[i] == snr)
+    {
+      return m_pers[i];
+    }
+  double a = m_pers[i];
+  double b = m_pers[i + 1];
+  return a + (snr - m_snrs[i]) * (b - a) / (m_snrs[i + 1] - m_snrs[i]);
 }
 
 } //namespace ns3
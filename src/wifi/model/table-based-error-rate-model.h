@@ -30,6 +30,41 @@ namespace ns3 {
 
 class WifiTxVector;
 
+/**
+ * \ingroup wifi
+ * \brief Lookup of the PER in a table of SNR and PER pairs
+ *
+ * The SNR values of the table are copied in a contiguous array when the
+ * lookup is built. If they are uniformly spaced (which is the case for
+ * all the reference tables), the index of the SNR is computed in constant
+ * time; otherwise, it is found by binary search. The PER returned for a
+ * given SNR is the one of the table if the SNR is in the table, and is
+ * linearly interpolated between the surrounding values otherwise.
+ */
+class SnrPerTableLookup
+{
+public:
+  /**
+   * Build the lookup of a table
+   *
+   * \param table the table of SNR (dB) and PER pairs, sorted by increasing SNR
+   */
+  SnrPerTableLookup (const SnrPerTable &table);
+
+  /**
+   * \param snr the SNR (dB)
+   * \return the PER for the given SNR
+   */
+  double GetPer (double snr) const;
+
+private:
+  std::vector<double> m_snrs; //!< the SNR values (dB)
+  std::vector<double> m_pers; //!< the PER values
+  double m_minSnr;            //!< the smallest SNR (dB)
+  double m_maxSnr;            //!< the largest SNR (dB)
+  double m_step;              //!< the SNR step (dB) if the SNR values are uniformly spaced, 0 otherwise
+};
+
 /*
  * \ingroup wifi
  * \brief the interface for the table-driven OFDM error model
@@ -58,6 +93,40 @@ public:
 private:
   double DoGetChunkSuccessRate (WifiMode mode, const WifiTxVector& txVector, double snr, uint64_t nbits,
                                 uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const override;
+  void DoGetChunkSuccessRates (WifiMode mode, const WifiTxVector& txVector, const std::vector<double>& snrs,
+                               const std::vector<uint64_t>& nbits, std::vector<double>& successRates,
+                               uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const override;
+
+  /**
+   * Get the lookups of the reference tables, which are built the first time
+   * this method is called and shared by all the instances of this class.
+   *
+   * \param ldpc whether the LDPC tables are requested (BCC tables otherwise)
+   * \param smallFrames whether the tables of small frames are requested (BCC only)
+   * \return the lookups of the tables, indexed by MCS
+   */
+  static const std::vector<SnrPerTableLookup> & GetLookups (bool ldpc, bool smallFrames);
+
+  /**
+   * Get the MCS whose table is used for a given mode, or the value 0xff
+   * if there is no table for the mode.
+   *
+   * \param mode the Wi-Fi mode
+   * \param ldpc whether LDPC is used
+   * \return the MCS whose table is used for the mode
+   */
+  uint8_t GetTableMcs (WifiMode mode, bool ldpc) const;
+
+  /**
+   * Compute the PER of a chunk from the tables.
+   *
+   * \param mcs the MCS whose table is used
+   * \param ldpc whether LDPC is used
+   * \param snr the SNR of the chunk (linear scale)
+   * \param nbits the number of bits in the chunk
+   * \return the PER of the chunk
+   */
+  double GetTablePer (uint8_t mcs, bool ldpc, double snr, uint64_t nbits) const;
 
   /**
    * Round SNR (in dB) to the specified precision
@@ -28,6 +28,7 @@
 #include "wifi-mac-header.h"
 #include "amsdu-subframe-header.h"
 #include <list>
+#include <map>
 
 namespace ns3 {
 
@@ -189,13 +190,18 @@ private:
    */
   void DoAggregate (Ptr<const WifiMacQueueItem> msdu);
 
-  friend class WifiMacQueue;  // to set QueueIteratorPair information
+  friend class WifiMacQueue;  // to set QueueIteratorPair and indexing information
 
   Ptr<const Packet> m_packet;                   //!< The packet (MSDU or A-MSDU) contained in this queue item
   WifiMacHeader m_header;                       //!< Wifi MAC header associated with the packet
   Time m_tstamp;                                //!< timestamp when the packet arrived at the queue
   DeaggregatedMsdus m_msduList;                 //!< The list of aggregated MSDUs included in this MPDU
   std::list<QueueIteratorPair> m_queueIts;      //!< Queue iterators pointing to this MSDU(s), if queued
+
+  // the following fields are only meaningful while the item is queued
+  int64_t m_queueOrder;                                     //!< key giving the order of the item in the queue
+  std::list<ConstIterator>::iterator m_subQueueIt;          //!< position of the item in its sub-queue (data frames only)
+  std::multimap<Time, ConstIterator>::iterator m_expiryIt;  //!< position of the item in the expiry index of the queue
 };
 
 /**
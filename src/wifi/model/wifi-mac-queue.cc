@@ -25,6 +25,8 @@
 #include "wifi-mac-queue.h"
 #include "qos-blocked-destinations.h"
 #include <functional>
+#include <algorithm>
+#include <limits>
 
 namespace ns3 {
 
@@ -33,6 +35,9 @@ NS_LOG_COMPONENT_DEFINE ("WifiMacQueue");
 NS_OBJECT_ENSURE_REGISTERED (WifiMacQueue);
 NS_OBJECT_TEMPLATE_CLASS_DEFINE (Queue, WifiMacQueueItem);
 
+/// Difference between the order keys of items enqueued at the head or at the tail of the queue
+static const int64_t QUEUE_ORDER_GAP = 1 << 20;
+
 TypeId
 WifiMacQueue::GetTypeId (void)
 {
@@ -71,8 +76,17 @@ WifiMacQueue::WifiMacQueue ()
 WifiMacQueue::~WifiMacQueue ()
 {
   NS_LOG_FUNCTION_NOARGS ();
-  m_nQueuedPackets.clear ();
-  m_nQueuedBytes.clear ();
+  m_subQueues.clear ();
+  m_expiryIndex.clear ();
+}
+
+void
+WifiMacQueue::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_subQueues.clear ();
+  m_expiryIndex.clear ();
+  Queue<WifiMacQueueItem>::DoDispose ();
 }
 
 static std::list<Ptr<WifiMacQueueItem>> g_emptyWifiMacQueue; //!< empty Wi-Fi MAC queue
@@ -109,6 +123,51 @@ WifiMacQueue::TtlExceeded (ConstIterator &it)
   return false;
 }
 
+void
+WifiMacQueue::RemoveExpired (ConstIterator pos)
+{
+  NS_LOG_FUNCTION (this);
+  int64_t posOrder = (pos != end () ? (*pos)->m_queueOrder : std::numeric_limits<int64_t>::max ());
+  std::vector<ConstIterator> expired;
+  for (auto it = m_expiryIndex.begin ();
+       it != m_expiryIndex.end () && Simulator::Now () > it->first + m_maxDelay; it++)
+    {
+      if ((*it->second)->m_queueOrder < posOrder)
+        {
+          expired.push_back (it->second);
+        }
+    }
+  // remove the expired items in the order of the queue, as a scan of the queue would do
+  std::sort (expired.begin (), expired.end (),
+             [] (ConstIterator a, ConstIterator b) { return (*a)->m_queueOrder < (*b)->m_queueOrder; });
+  for (ConstIterator it : expired)
+    {
+      TtlExceeded (it);
+    }
+}
+
+void
+WifiMacQueue::SignalExpired (ConstIterator first, ConstIterator last) const
+{
+  if (m_expiredPacketsPresent || first == last)
+    {
+      return;
+    }
+  int64_t firstOrder = (first != end () ? (*first)->m_queueOrder : std::numeric_limits<int64_t>::max ());
+  int64_t lastOrder = (last != end () ? (*last)->m_queueOrder : std::numeric_limits<int64_t>::max ());
+  for (auto it = m_expiryIndex.begin ();
+       it != m_expiryIndex.end () && Simulator::Now () > it->first + m_maxDelay; it++)
+    {
+      int64_t order = (*it->second)->m_queueOrder;
+      if (order >= firstOrder && order < lastOrder)
+        {
+          // signal the presence of expired packets
+          m_expiredPacketsPresent = true;
+          return;
+        }
+    }
+}
+
 bool
 WifiMacQueue::Enqueue (Ptr<WifiMacQueueItem> item)
 {
@@ -138,19 +197,22 @@ WifiMacQueue::Insert (ConstIterator pos, Ptr<WifiMacQueueItem> item)
       return DoEnqueue (pos, item);
     }
 
-  // the queue is full; scan the list in the attempt to remove stale packets
-  ConstIterator it = begin ();
-  while (it != end ())
+  // the queue is full; attempt to remove the first (in the order of the queue)
+  // stale packet
+  ConstIterator it = end ();
+  for (auto expIt = m_expiryIndex.begin ();
+       expIt != m_expiryIndex.end () && Simulator::Now () > expIt->first + m_maxDelay; expIt++)
     {
-      if (it == pos && TtlExceeded (it))
+      if (it == end () || (*expIt->second)->m_queueOrder < (*it)->m_queueOrder)
         {
-          return DoEnqueue (it, item);
+          it = expIt->second;
         }
-      if (TtlExceeded (it))
-        {
-          return DoEnqueue (pos, item);
-        }
-      it++;
+    }
+  if (it != end ())
+    {
+      bool isPos = (it == pos);
+      TtlExceeded (it);
+      return DoEnqueue (isPos ? it : pos, item);
     }
 
   // the queue is still full, remove the oldest item if the policy is drop oldest
@@ -254,28 +316,24 @@ WifiMacQueue::Dequeue (ConstIterator pos)
       return DoDequeue (pos);
     }
 
-  // remove stale items queued before the given position
-  ConstIterator it = begin ();
-  while (it != end ())
+  if (pos == EMPTY)
     {
-      if (it == pos)
-        {
-          // reset the flag signaling the presence of expired packets before returning
-          m_expiredPacketsPresent = false;
+      // no item to dequeue, just remove all the stale items
+      RemoveExpired (end ());
+      NS_LOG_DEBUG ("Invalid iterator");
+      return 0;
+    }
 
-          if (TtlExceeded (it))
-            {
-              return 0;
-            }
-          return DoDequeue (it);
-        }
-      else if (!TtlExceeded (it))
-        {
-          it++;
-        }
+  // remove stale items queued before the given position
+  RemoveExpired (pos);
+  // reset the flag signaling the presence of expired packets before returning
+  m_expiredPacketsPresent = false;
+
+  if (TtlExceeded (pos))
+    {
+      return 0;
     }
-  NS_LOG_DEBUG ("Invalid iterator");
-  return 0;
+  return DoDequeue (pos);
 }
 
 Ptr<const WifiMacQueueItem>
@@ -301,28 +359,28 @@ WifiMacQueue::ConstIterator
 WifiMacQueue::PeekByAddress (Mac48Address dest, ConstIterator pos) const
 {
   NS_LOG_FUNCTION (this << dest);
-  ConstIterator it = (pos != EMPTY ? pos : begin ());
-  while (it != end ())
+  ConstIterator first = (pos != EMPTY ? pos : begin ());
+  ConstIterator ret = end ();
+  auto subQueuesIt = m_subQueues.find (dest);
+  if (subQueuesIt != m_subQueues.end ())
     {
-      // skip packets that stayed in the queue for too long. They will be
-      // actually removed from the queue by the next call to a non-const method
-      if (Simulator::Now () <= (*it)->GetTimeStamp () + m_maxDelay)
+      // the first of the items found in each sub-queue of the receiver
+      for (std::size_t index = 0; index <= NON_QOS_SUB_QUEUE; index++)
         {
-          if (((*it)->GetHeader ().IsData () || (*it)->GetHeader ().IsQosData ())
-              && (*it)->GetDestinationAddress () == dest)
+          ConstIterator it = PeekSubQueue (subQueuesIt->second[index], dest, index, pos);
+          if (it != end () && (ret == end () || (*it)->m_queueOrder < (*ret)->m_queueOrder))
             {
-              return it;
+              ret = it;
             }
         }
-      else
-        {
-          // signal the presence of expired packets
-          m_expiredPacketsPresent = true;
-        }
-      it++;
     }
-  NS_LOG_DEBUG ("The queue is empty");
-  return end ();
+  // expired packets are skipped as if the queue were scanned from the first position
+  SignalExpired (first, ret);
+  if (ret == end ())
+    {
+      NS_LOG_DEBUG ("The queue is empty");
+    }
+  return ret;
 }
 
 WifiMacQueue::ConstIterator
@@ -356,28 +414,86 @@ WifiMacQueue::ConstIterator
 WifiMacQueue::PeekByTidAndAddress (uint8_t tid, Mac48Address dest, ConstIterator pos) const
 {
   NS_LOG_FUNCTION (this << +tid << dest);
-  ConstIterator it = (pos != EMPTY ? pos : begin ());
-  while (it != end ())
+  ConstIterator first = (pos != EMPTY ? pos : begin ());
+  ConstIterator ret = end ();
+  const SubQueue* subQueue = GetSubQueue (dest, tid);
+  if (subQueue != nullptr)
     {
-      // skip packets that stayed in the queue for too long. They will be
-      // actually removed from the queue by the next call to a non-const method
-      if (Simulator::Now () <= (*it)->GetTimeStamp () + m_maxDelay)
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              return it;
-            }
-        }
-      else
+      ret = PeekSubQueue (*subQueue, dest, tid, pos);
+    }
+  // expired packets are skipped as if the queue were scanned from the first position
+  SignalExpired (first, ret);
+  if (ret == end ())
+    {
+      NS_LOG_DEBUG ("The queue is empty");
+    }
+  return ret;
+}
+
+std::size_t
+WifiMacQueue::GetSubQueueIndex (const WifiMacHeader &header)
+{
+  NS_ASSERT (header.IsData ());
+  return (header.IsQosData () ? header.GetQosTid () : NON_QOS_SUB_QUEUE);
+}
+
+const WifiMacQueue::SubQueue*
+WifiMacQueue::GetSubQueue (Mac48Address dest, std::size_t index) const
+{
+  NS_ASSERT (index <= NON_QOS_SUB_QUEUE);
+  auto it = m_subQueues.find (dest);
+  if (it == m_subQueues.end ())
+    {
+      return nullptr;
+    }
+  return &it->second[index];
+}
+
+WifiMacQueue::ConstIterator
+WifiMacQueue::PeekSubQueue (const SubQueue &subQueue, Mac48Address dest, std::size_t index,
+                            ConstIterator pos) const
+{
+  auto inSubQueue = [dest, index] (ConstIterator it)
+    {
+      const WifiMacHeader &header = (*it)->GetHeader ();
+      return header.IsData () && header.GetAddr1 () == dest && GetSubQueueIndex (header) == index;
+    };
+
+  std::list<ConstIterator>::const_iterator it;
+  if (pos == EMPTY || pos == begin ())
+    {
+      it = subQueue.items.begin ();
+    }
+  else if (pos == end ())
+    {
+      it = subQueue.items.end ();
+    }
+  else if (inSubQueue (pos))
+    {
+      it = (*pos)->m_subQueueIt;
+    }
+  else if (inSubQueue (std::prev (pos)))
+    {
+      // typically, pos follows the item previously returned by a search
+      it = std::next ((*std::prev (pos))->m_subQueueIt);
+    }
+  else
+    {
+      // find the first item of the sub-queue that follows pos
+      it = subQueue.items.begin ();
+      while (it != subQueue.items.end () && (**it)->m_queueOrder < (*pos)->m_queueOrder)
         {
-          // signal the presence of expired packets
-          m_expiredPacketsPresent = true;
+          it++;
         }
+    }
+
+  // skip packets that stayed in the queue for too long. They will be
+  // actually removed from the queue by the next call to a non-const method
+  while (it != subQueue.items.end () && Simulator::Now () > (**it)->GetTimeStamp () + m_maxDelay)
+    {
       it++;
     }
-  NS_LOG_DEBUG ("The queue is empty");
-  return end ();
+  return (it != subQueue.items.end () ? *it : end ());
 }
 
 WifiMacQueue::ConstIterator
@@ -457,45 +573,38 @@ WifiMacQueue::Remove (ConstIterator pos, bool removeExpired)
       return pos;
     }
 
-  // remove stale items queued before the given position
-  ConstIterator it = begin ();
-  while (it != end ())
+  if (pos == EMPTY)
     {
-      if (it == pos)
-        {
-          // reset the flag signaling the presence of expired packets before returning
-          m_expiredPacketsPresent = false;
-
-          ConstIterator curr = pos++;
-          DoRemove (curr);
-          return pos;
-        }
-      else if (!TtlExceeded (it))
-        {
-          it++;
-        }
+      // no item to remove, just remove all the stale items
+      RemoveExpired (end ());
+      NS_LOG_DEBUG ("Invalid iterator");
+      return end ();
     }
-  NS_LOG_DEBUG ("Invalid iterator");
-  return end ();
+
+  // remove stale items queued before the given position
+  RemoveExpired (pos);
+  // reset the flag signaling the presence of expired packets before returning
+  m_expiredPacketsPresent = false;
+
+  ConstIterator curr = pos++;
+  DoRemove (curr);
+  return pos;
 }
 
 uint32_t
 WifiMacQueue::GetNPacketsByAddress (Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
+  // remove packets that stayed in the queue for too long
+  RemoveExpired (end ());
 
   uint32_t nPackets = 0;
-
-  for (ConstIterator it = begin (); it != end (); )
+  auto it = m_subQueues.find (dest);
+  if (it != m_subQueues.end ())
     {
-      if (!TtlExceeded (it))
+      for (const auto & subQueue : it->second)
         {
-          if ((*it)->GetHeader ().IsData () && (*it)->GetDestinationAddress () == dest)
-            {
-              nPackets++;
-            }
-
-          it++;
+          nPackets += subQueue.items.size ();
         }
     }
   NS_LOG_DEBUG ("returns " << nPackets);
@@ -506,20 +615,10 @@ uint32_t
 WifiMacQueue::GetNPacketsByTidAndAddress (uint8_t tid, Mac48Address dest)
 {
   NS_LOG_FUNCTION (this << dest);
-  uint32_t nPackets = 0;
-  for (ConstIterator it = begin (); it != end (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          if ((*it)->GetHeader ().IsQosData () && (*it)->GetDestinationAddress () == dest
-              && (*it)->GetHeader ().GetQosTid () == tid)
-            {
-              nPackets++;
-            }
+  // remove packets that stayed in the queue for too long
+  RemoveExpired (end ());
 
-          it++;
-        }
-    }
+  uint32_t nPackets = GetNPackets (tid, dest);
   NS_LOG_DEBUG ("returns " << nPackets);
   return nPackets;
 }
@@ -545,13 +644,7 @@ WifiMacQueue::GetNPackets (void)
 {
   NS_LOG_FUNCTION (this);
   // remove packets that stayed in the queue for too long
-  for (ConstIterator it = begin (); it != end (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  RemoveExpired (end ());
   return QueueBase::GetNPackets ();
 }
 
@@ -560,59 +653,117 @@ WifiMacQueue::GetNBytes (void)
 {
   NS_LOG_FUNCTION (this);
   // remove packets that stayed in the queue for too long
-  for (ConstIterator it = begin (); it != end (); )
-    {
-      if (!TtlExceeded (it))
-        {
-          it++;
-        }
-    }
+  RemoveExpired (end ());
   return QueueBase::GetNBytes ();
 }
 
 uint32_t
 WifiMacQueue::GetNPackets (uint8_t tid, Mac48Address dest) const
 {
-  WifiAddressTidPair addressTidPair (dest, tid);
-  auto it = m_nQueuedPackets.find (addressTidPair);
-  if (it == m_nQueuedPackets.end ())
+  const SubQueue* subQueue = GetSubQueue (dest, tid);
+  if (subQueue == nullptr)
     {
       return 0;
     }
-  return m_nQueuedPackets.at (addressTidPair);
+  return subQueue->items.size ();
 }
 
 uint32_t
 WifiMacQueue::GetNBytes (uint8_t tid, Mac48Address dest) const
 {
-  WifiAddressTidPair addressTidPair (dest, tid);
-  auto it = m_nQueuedBytes.find (addressTidPair);
-  if (it == m_nQueuedBytes.end ())
+  const SubQueue* subQueue = GetSubQueue (dest, tid);
+  if (subQueue == nullptr)
     {
       return 0;
     }
-  return m_nQueuedBytes.at (addressTidPair);
+  return subQueue->nBytes;
 }
 
-bool
-WifiMacQueue::DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item)
+void
+WifiMacQueue::SetQueueOrder (ConstIterator pos)
 {
-  Iterator ret;
-  if (Queue<WifiMacQueueItem>::DoEnqueue (pos, item, ret))
+  ConstIterator next = std::next (pos);
+  if (pos == begin () && next == end ())
+    {
+      (*pos)->m_queueOrder = 0;
+    }
+  else if (next == end ())
+    {
+      (*pos)->m_queueOrder = (*std::prev (pos))->m_queueOrder + QUEUE_ORDER_GAP;
+    }
+  else if (pos == begin ())
+    {
+      (*pos)->m_queueOrder = (*next)->m_queueOrder - QUEUE_ORDER_GAP;
+    }
+  else
+    {
+      if ((*next)->m_queueOrder - (*std::prev (pos))->m_queueOrder < 2)
+        {
+          // no room left between the previous and the next items, renumber all the items
+          NS_LOG_DEBUG ("Renumbering the items in the queue");
+          int64_t order = 0;
+          for (auto & item : *this)
+            {
+              item->m_queueOrder = order;
+              order += QUEUE_ORDER_GAP;
+            }
+        }
+      int64_t prevOrder = (*std::prev (pos))->m_queueOrder;
+      (*pos)->m_queueOrder = prevOrder + ((*next)->m_queueOrder - prevOrder) / 2;
+    }
+}
+
+void
+WifiMacQueue::AddToIndices (ConstIterator pos)
+{
+  Ptr<WifiMacQueueItem> item = *pos;
+  SetQueueOrder (pos);
+  const WifiMacHeader &header = item->GetHeader ();
+  if (header.IsData ())
     {
-      // update statistics about queued packets
-      if (item->GetHeader ().IsQosData ())
+      SubQueue &subQueue = m_subQueues[header.GetAddr1 ()][GetSubQueueIndex (header)];
+      auto subQueuePos = subQueue.items.end ();
+      if (!subQueue.items.empty () && (*subQueue.items.back ())->m_queueOrder > item->m_queueOrder)
         {
-          WifiAddressTidPair addressTidPair (item->GetHeader ().GetAddr1 (), item->GetHeader ().GetQosTid ());
-          auto it = m_nQueuedPackets.find (addressTidPair);
-          if (it == m_nQueuedPackets.end ())
+          // the item is not enqueued after all the other items of its sub-queue
+          subQueuePos = subQueue.items.begin ();
+          while ((**subQueuePos)->m_queueOrder < item->m_queueOrder)
             {
-              m_nQueuedPackets[addressTidPair] = 0;
-              m_nQueuedBytes[addressTidPair] = 0;
+              subQueuePos++;
             }
-          m_nQueuedPackets[addressTidPair]++;
-          m_nQueuedBytes[addressTidPair] += item->GetSize ();
         }
+      item->m_subQueueIt = subQueue.items.insert (subQueuePos, pos);
+      subQueue.nBytes += item->GetSize ();
+    }
+  item->m_expiryIt = m_expiryIndex.insert ({item->GetTimeStamp (), pos});
+}
+
+void
+WifiMacQueue::RemoveFromIndices (ConstIterator pos)
+{
+  Ptr<WifiMacQueueItem> item = *pos;
+  const WifiMacHeader &header = item->GetHeader ();
+  if (header.IsData ())
+    {
+      auto it = m_subQueues.find (header.GetAddr1 ());
+      NS_ASSERT (it != m_subQueues.end ());
+      SubQueue &subQueue = it->second[GetSubQueueIndex (header)];
+      NS_ASSERT (!subQueue.items.empty ());
+      NS_ASSERT (subQueue.nBytes >= item->GetSize ());
+      subQueue.items.erase (item->m_subQueueIt);
+      subQueue.nBytes -= item->GetSize ();
+    }
+  m_expiryIndex.erase (item->m_expiryIt);
+}
+
+bool
+WifiMacQueue::DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item)
+{
+  Iterator ret;
+  if (Queue<WifiMacQueueItem>::DoEnqueue (pos, item, ret))
+    {
+      // update the sub-queues and the expiry index
+      AddToIndices (ret);
       // set item's information about its position in the queue
       item->m_queueIts = {{this, ret}};
       return true;
@@ -623,18 +774,12 @@ WifiMacQueue::DoEnqueue (ConstIterator pos, Ptr<WifiMacQueueItem> item)
 Ptr<WifiMacQueueItem>
 WifiMacQueue::DoDequeue (ConstIterator pos)
 {
-  Ptr<WifiMacQueueItem> item = Queue<WifiMacQueueItem>::DoDequeue (pos);
-
-  if (item != 0 && item->GetHeader ().IsQosData ())
+  if (QueueBase::IsEmpty ())
     {
-      WifiAddressTidPair addressTidPair (item->GetHeader ().GetAddr1 (), item->GetHeader ().GetQosTid ());
-      NS_ASSERT (m_nQueuedPackets.find (addressTidPair) != m_nQueuedPackets.end ());
-      NS_ASSERT (m_nQueuedPackets[addressTidPair] >= 1);
-      NS_ASSERT (m_nQueuedBytes[addressTidPair] >= item->GetSize ());
-
-      m_nQueuedPackets[addressTidPair]--;
-      m_nQueuedBytes[addressTidPair] -= item->GetSize ();
+      return 0;
     }
+  RemoveFromIndices (pos);
+  Ptr<WifiMacQueueItem> item = Queue<WifiMacQueueItem>::DoDequeue (pos);
 
   if (item != 0)
     {
@@ -648,18 +793,12 @@ WifiMacQueue::DoDequeue (ConstIterator pos)
 Ptr<WifiMacQueueItem>
 WifiMacQueue::DoRemove (ConstIterator pos)
 {
-  Ptr<WifiMacQueueItem> item = Queue<WifiMacQueueItem>::DoRemove (pos);
-
-  if (item != 0 && item->GetHeader ().IsQosData ())
+  if (QueueBase::IsEmpty ())
     {
-      WifiAddressTidPair addressTidPair (item->GetHeader ().GetAddr1 (), item->GetHeader ().GetQosTid ());
-      NS_ASSERT (m_nQueuedPackets.find (addressTidPair) != m_nQueuedPackets.end ());
-      NS_ASSERT (m_nQueuedPackets[addressTidPair] >= 1);
-      NS_ASSERT (m_nQueuedBytes[addressTidPair] >= item->GetSize ());
-
-      m_nQueuedPackets[addressTidPair]--;
-      m_nQueuedBytes[addressTidPair] -= item->GetSize ();
+      return 0;
     }
+  RemoveFromIndices (pos);
+  Ptr<WifiMacQueueItem> item = Queue<WifiMacQueueItem>::DoRemove (pos);
 
   if (item != 0)
     {
@@ -27,6 +27,8 @@
 #include "wifi-mac-queue-item.h"
 #include "ns3/queue.h"
 #include <unordered_map>
+#include <array>
+#include <map>
 #include "qos-utils.h"
 
 namespace ns3 {
@@ -55,6 +57,14 @@ extern template class Queue<WifiMacQueueItem>;
  * to verify whether or not it should be dropped. If
  * dot11EDCATableMSDULifetime has elapsed, it is dropped.
  * Otherwise, it is returned to the caller.
+ *
+ * Besides the list of items in the order of the queue, the queue keeps
+ * a sub-queue per receiver address and TID (plus one per receiver for
+ * non-QoS data frames) linking the data frames in the order of the queue,
+ * and an index of the items sorted by timestamp. Hence, searching for the
+ * data frames addressed to a receiver (and having a given TID) does not
+ * scan the frames addressed to other receivers, and removing the expired
+ * items does not scan the items whose lifetime has not expired.
  */
 class WifiMacQueue : public Queue<WifiMacQueueItem>
 {
@@ -262,7 +272,7 @@ public:
   ConstIterator Remove (ConstIterator pos, bool removeExpired = false);
   /**
    * Return the number of packets having destination address specified by
-   * <i>dest</i>. The complexity is linear in the size of the queue.
+   * <i>dest</i>. Expired packets are removed from the queue first.
    *
    * \param dest the given destination
    *
@@ -271,8 +281,8 @@ public:
   uint32_t GetNPacketsByAddress (Mac48Address dest);
   /**
    * Return the number of QoS packets having TID equal to <i>tid</i> and
-   * destination address equal to <i>dest</i>.  The complexity is linear in
-   * the size of the queue.
+   * destination address equal to <i>dest</i>. Expired packets are removed
+   * from the queue first.
    *
    * \param tid the given TID
    * \param dest the given destination
@@ -330,7 +340,24 @@ public:
   static const ConstIterator EMPTY;         //!< Invalid iterator to signal an empty queue
 
 
+protected:
+  void DoDispose (void) override;
+
 private:
+  /// Index of the sub-queue of a receiver storing the non-QoS data frames
+  static const std::size_t NON_QOS_SUB_QUEUE = 16;
+
+  /// A sub-queue, i.e., the data frames addressed to a receiver and having
+  /// a given TID (or not being QoS data frames), in the order of the queue
+  struct SubQueue
+  {
+    std::list<ConstIterator> items;  //!< iterators pointing to the items in the queue
+    uint32_t nBytes = 0;             //!< number of bytes of the items
+  };
+
+  /// The sub-queues of a receiver, indexed by TID or NON_QOS_SUB_QUEUE
+  typedef std::array<SubQueue, NON_QOS_SUB_QUEUE + 1> ReceiverSubQueues;
+
   /**
    * Remove the item pointed to by the iterator <i>it</i> if it has been in the
    * queue for too long. If the item is removed, the iterator is updated to
@@ -340,6 +367,64 @@ private:
    * \return true if the item is removed, false otherwise
    */
   bool TtlExceeded (ConstIterator &it);
+  /**
+   * Remove, in the order of the queue, the items queued before the given
+   * position whose lifetime expired.
+   *
+   * \param pos the position (all the expired items are removed if it is end ())
+   */
+  void RemoveExpired (ConstIterator pos);
+  /**
+   * Set the flag signaling the presence of expired packets if the lifetime of
+   * any of the items from <i>first</i> (included) to <i>last</i> (excluded)
+   * expired.
+   *
+   * \param first the first position of the range
+   * \param last the position following the last one of the range
+   */
+  void SignalExpired (ConstIterator first, ConstIterator last) const;
+  /**
+   * \param header the MAC header of a data frame
+   * \return the index of the sub-queue of the receiver storing the data frame
+   */
+  static std::size_t GetSubQueueIndex (const WifiMacHeader &header);
+  /**
+   * \param dest the receiver address
+   * \param index the index of the sub-queue of the receiver
+   * \return the given sub-queue, or a null pointer if no frame was ever queued for the receiver
+   */
+  const SubQueue* GetSubQueue (Mac48Address dest, std::size_t index) const;
+  /**
+   * Return the first item of a sub-queue that is neither queued before the
+   * given position nor expired.
+   *
+   * \param subQueue the sub-queue
+   * \param dest the receiver address of the sub-queue
+   * \param index the index of the sub-queue
+   * \param pos the position the search starts from (EMPTY to start from the head of the queue)
+   * \return an iterator pointing to the item, or end () if there is no such item
+   */
+  ConstIterator PeekSubQueue (const SubQueue &subQueue, Mac48Address dest, std::size_t index,
+                              ConstIterator pos) const;
+  /**
+   * Set the order key of the item at the given position, which must lie between
+   * the order keys of the previous and the next items.
+   *
+   * \param pos the position of the item
+   */
+  void SetQueueOrder (ConstIterator pos);
+  /**
+   * Add the item at the given position to the sub-queues and to the expiry index.
+   *
+   * \param pos the position of the item
+   */
+  void AddToIndices (ConstIterator pos);
+  /**
+   * Remove the item at the given position from the sub-queues and from the expiry index.
+   *
+   * \param pos the position of the item
+   */
+  void RemoveFromIndices (ConstIterator pos);
   /**
    * Wrapper for the DoEnqueue method provided by the base class that additionally
    * sets the iterator field of the item and updates internal statistics, if
@@ -373,10 +458,10 @@ private:
   DropPolicy m_dropPolicy;                  //!< Drop behavior of queue
   mutable bool m_expiredPacketsPresent;     //!< True if expired packets are in the queue
 
-  /// Per (MAC address, TID) pair queued packets
-  std::unordered_map<WifiAddressTidPair, uint32_t, WifiAddressTidHash> m_nQueuedPackets;
-  /// Per (MAC address, TID) pair queued bytes
-  std::unordered_map<WifiAddressTidPair, uint32_t, WifiAddressTidHash> m_nQueuedBytes;
+  /// Sub-queues of each receiver address
+  std::unordered_map<Mac48Address, ReceiverSubQueues, WifiAddressHash> m_subQueues;
+  /// Queued items sorted by timestamp, i.e., by expiration time
+  std::multimap<Time, ConstIterator> m_expiryIndex;
 
   /// Traced callback: fired when a packet is dropped due to lifetime expiration
   TracedCallback<Ptr<const WifiMacQueueItem> > m_traceExpired;
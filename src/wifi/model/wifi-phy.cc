@@ -23,6 +23,7 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/pointer.h"
+#include "ns3/enum.h"
 #include "ns3/mobility-model.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/error-model.h"
@@ -471,6 +472,15 @@ WifiPhy::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&WifiPhy::m_postReceptionErrorModel),
                    MakePointerChecker<ErrorModel> ())
+    .AddAttribute ("InterferenceTimeline",
+                   "The storage used to record noise and interference changes: "
+                   "a multimap per band (Multimap) or a time-ordered array per band (Flat). "
+                   "Both yield the same SNR and PER, the latter with fewer allocations.",
+                   EnumValue (InterferenceHelper::TIMELINE_MULTIMAP),
+                   MakeEnumAccessor (&WifiPhy::SetInterferenceTimeline,
+                                     &WifiPhy::GetInterferenceTimeline),
+                   MakeEnumChecker (InterferenceHelper::TIMELINE_MULTIMAP, "Multimap",
+                                    InterferenceHelper::TIMELINE_FLAT, "Flat"))
     .AddAttribute ("Sifs",
                    "The duration of the Short Interframe Space. "
                    "NOTE that the default value is overwritten by the value defined "
@@ -811,6 +821,19 @@ WifiPhy::SetErrorRateModel (const Ptr<ErrorRateModel> rate)
   m_interference.SetNumberOfReceiveAntennas (GetNumberOfAntennas ());
 }
 
+void
+WifiPhy::SetInterferenceTimeline (InterferenceHelper::TimelineType type)
+{
+  NS_LOG_FUNCTION (this << type);
+  m_interference.SetTimelineType (type);
+}
+
+InterferenceHelper::TimelineType
+WifiPhy::GetInterferenceTimeline (void) const
+{
+  return m_interference.GetTimelineType ();
+}
+
 void
 WifiPhy::SetPostReceptionErrorModel (const Ptr<ErrorModel> em)
 {
@@ -1887,7 +1910,7 @@ WifiPhy::Reset (void)
 }
 
 void
-WifiPhy::StartReceivePreamble (Ptr<WifiPpdu> ppdu, RxPowerWattPerChannelBand rxPowersW, Time rxDuration)
+WifiPhy::StartReceivePreamble (Ptr<const WifiPpdu> ppdu, RxPowerWattPerChannelBand rxPowersW, Time rxDuration)
 {
   WifiModulationClass modulation = ppdu->GetTxVector ().GetModulationClass ();
   auto it = m_phyEntities.find (modulation);
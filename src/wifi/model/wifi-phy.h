@@ -105,7 +105,7 @@ public:
    * \param rxPowersW the receive power in W per band
    * \param rxDuration the duration of the PPDU
    */
-  void StartReceivePreamble (Ptr<WifiPpdu> ppdu, RxPowerWattPerChannelBand rxPowersW, Time rxDuration);
+  void StartReceivePreamble (Ptr<const WifiPpdu> ppdu, RxPowerWattPerChannelBand rxPowersW, Time rxDuration);
 
   /**
    * Reset PHY at the end of the packet under reception after it has failed the PHY header.
@@ -927,6 +927,18 @@ public:
    * \param rate the error rate model
    */
   void SetErrorRateModel (const Ptr<ErrorRateModel> rate);
+  /**
+   * Sets the storage used by the interference helper to record
+   * noise and interference changes.
+   *
+   * \param type the timeline type
+   */
+  void SetInterferenceTimeline (InterferenceHelper::TimelineType type);
+  /**
+   * \return the storage used by the interference helper to record
+   *         noise and interference changes
+   */
+  InterferenceHelper::TimelineType GetInterferenceTimeline (void) const;
   /**
    * Attach a receive ErrorModel to the WifiPhy.
    *
@@ -27,6 +27,8 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("WifiPpdu");
 
+std::atomic<uint64_t> WifiPpdu::m_nCreated (0);
+
 WifiPpdu::WifiPpdu (Ptr<const WifiPsdu> psdu, const WifiTxVector& txVector, uint64_t uid /* = UINT64_MAX */)
   : m_preamble (txVector.GetPreambleType ()),
     m_modulation (txVector.IsValid () ? txVector.GetModulationClass () : WIFI_MOD_CLASS_UNKNOWN),
@@ -35,6 +37,7 @@ WifiPpdu::WifiPpdu (Ptr<const WifiPsdu> psdu, const WifiTxVector& txVector, uint
     m_txPowerLevel (txVector.GetTxPowerLevel ())
 {
   NS_LOG_FUNCTION (this << *psdu << txVector << uid);
+  m_nCreated++;
   m_psdus.insert (std::make_pair (SU_STA_ID, psdu));
 }
 
@@ -47,6 +50,7 @@ WifiPpdu::WifiPpdu (const WifiConstPsduMap & psdus, const WifiTxVector& txVector
     m_txAntennas (txVector.GetNTx ())
 {
   NS_LOG_FUNCTION (this << psdus << txVector << uid);
+  m_nCreated++;
   m_psdus = psdus;
 }
 
@@ -150,6 +154,12 @@ WifiPpdu::PrintPayload (void) const
   return ss.str ();
 }
 
+uint64_t
+WifiPpdu::GetNCreated (void)
+{
+  return m_nCreated;
+}
+
 Ptr<WifiPpdu>
 WifiPpdu::Copy (void) const
 {
@@ -157,6 +167,17 @@ WifiPpdu::Copy (void) const
   return Create<WifiPpdu> (GetPsdu (), GetTxVector ());
 }
 
+Ptr<WifiPpdu>
+WifiPpdu::DeepCopy (void) const
+{
+  Ptr<WifiPpdu> copy = Copy ();
+  for (auto & psdu : copy->m_psdus)
+    {
+      psdu.second = psdu.second->DeepCopy ();
+    }
+  return copy;
+}
+
 std::ostream & operator << (std::ostream &os, const Ptr<const WifiPpdu> &ppdu)
 {
   ppdu->Print (os);
@@ -23,6 +23,7 @@
 
 #include "wifi-tx-vector.h"
 #include "ns3/nstime.h"
+#include <atomic>
 #include <list>
 #include <unordered_map>
 
@@ -131,6 +132,12 @@ public:
    * \return a Ptr to a copy of this instance.
    */
   virtual Ptr<WifiPpdu> Copy (void) const;
+  /**
+   * \brief Copy this instance and its PSDUs, including the packets of
+   * their MPDUs (\see WifiPsdu::DeepCopy).
+   * \return a Ptr to a deep copy of this instance.
+   */
+  Ptr<WifiPpdu> DeepCopy (void) const;
 
   /**
    * Return the PPDU type (\see WifiPpduType)
@@ -145,6 +152,15 @@ public:
    */
   virtual uint16_t GetStaId (void) const;
 
+  /**
+   * Get the number of PPDUs (including copies) created so far. Since PPDUs
+   * are shared by all the receivers, this is normally the number of
+   * transmitted PPDUs, plus one copy per HE TB PPDU for its OFDMA portion.
+   *
+   * \return the number of PPDUs created so far
+   */
+  static uint64_t GetNCreated (void);
+
 protected:
   /**
    * \brief Print the payload of the PPDU.
@@ -168,6 +184,8 @@ private:
   bool m_truncatedTx;     //!< flag indicating whether the frame's transmission was aborted due to transmitter switch off
   uint8_t m_txPowerLevel; //!< the transmission power level (used only for TX and initializing the returned WifiTxVector)
   uint8_t m_txAntennas;   //!< the number of antennas used to transmit this PPDU
+
+  static std::atomic<uint64_t> m_nCreated; //!< number of PPDUs created so far
 }; //class WifiPpdu
 
 /**
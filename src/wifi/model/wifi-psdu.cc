@@ -71,6 +71,24 @@ WifiPsdu::~WifiPsdu ()
 {
 }
 
+Ptr<WifiPsdu>
+WifiPsdu::DeepCopy (void) const
+{
+  Ptr<WifiPsdu> copy = Create<WifiPsdu> (*this);
+  std::vector<uint8_t> buffer;
+  for (auto& mpdu : copy->m_mpduList)
+    {
+      // the buffers of packet copies are shared, hence the packets are
+      // serialized and deserialized
+      Ptr<const Packet> packet = mpdu->GetPacket ();
+      buffer.resize (packet->GetSerializedSize ());
+      NS_ABORT_MSG_IF (packet->Serialize (buffer.data (), buffer.size ()) == 0, "Failed to serialize the packet");
+      mpdu = Create<WifiMacQueueItem> (Create<Packet> (buffer.data (), buffer.size (), true),
+                                       mpdu->GetHeader (), mpdu->GetTimeStamp ());
+    }
+  return copy;
+}
+
 bool
 WifiPsdu::IsSingle (void) const
 {
@@ -77,6 +77,15 @@ public:
 
   virtual ~WifiPsdu ();
 
+  /**
+   * Copy this PSDU, including the packets of its MPDUs, so that the copy
+   * shares no state with this PSDU (e.g., to hand it over to another
+   * thread of a multithreaded simulation).
+   *
+   * \return a deep copy of this PSDU
+   */
+  Ptr<WifiPsdu> DeepCopy (void) const;
+
   /**
    * Return true if the PSDU is an S-MPDU
    * \return true if the PSDU is an S-MPDU.
@@ -1208,16 +1208,11 @@ WifiRemoteStationManager::GetMostRecentRssi (Mac48Address address) const
 {
   double rssi = 0.0;
   Time mostRecentUpdateTime = NanoSeconds (0);
-  for (const auto & station : m_stations)
+  auto it = m_stations.find (address);
+  if (it != m_stations.end ())
     {
-      if (station->m_state->m_address == address) //get most recent RSSI irrespective of TID
-        {
-          if (station->m_rssiAndUpdateTimePair.second >= mostRecentUpdateTime)
-            {
-              rssi = station->m_rssiAndUpdateTimePair.first;
-              mostRecentUpdateTime = station->m_rssiAndUpdateTimePair.second;
-            }
-        }
+      rssi = it->second->m_rssiAndUpdateTimePair.first;
+      mostRecentUpdateTime = it->second->m_rssiAndUpdateTimePair.second;
     }
   NS_ASSERT (mostRecentUpdateTime.IsStrictlyPositive ());
   return rssi;
@@ -1227,13 +1222,11 @@ WifiRemoteStationState *
 WifiRemoteStationManager::LookupState (Mac48Address address) const
 {
   NS_LOG_FUNCTION (this << address);
-  for (StationStates::const_iterator i = m_states.begin (); i != m_states.end (); i++)
+  auto it = m_states.find (address);
+  if (it != m_states.end ())
     {
-      if ((*i)->m_address == address)
-        {
-          NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning existing state");
-          return (*i);
-        }
+      NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning existing state");
+      return it->second;
     }
   WifiRemoteStationState *state = new WifiRemoteStationState ();
   state->m_state = WifiRemoteStationState::BRAND_NEW;
@@ -1251,7 +1244,7 @@ WifiRemoteStationManager::LookupState (Mac48Address address) const
   state->m_ness = 0;
   state->m_aggregation = false;
   state->m_qosSupported = false;
-  const_cast<WifiRemoteStationManager *> (this)->m_states.push_back (state);
+  const_cast<WifiRemoteStationManager *> (this)->m_states.insert ({address, state});
   NS_LOG_DEBUG ("WifiRemoteStationManager::LookupState returning new state");
   return state;
 }
@@ -1260,19 +1253,17 @@ WifiRemoteStation *
 WifiRemoteStationManager::Lookup (Mac48Address address) const
 {
   NS_LOG_FUNCTION (this << address);
-  for (Stations::const_iterator i = m_stations.begin (); i != m_stations.end (); i++)
+  auto it = m_stations.find (address);
+  if (it != m_stations.end ())
     {
-      if ((*i)->m_state->m_address == address)
-        {
-          return (*i);
-        }
+      return it->second;
     }
   WifiRemoteStationState *state = LookupState (address);
 
   WifiRemoteStation *station = DoCreateStation ();
   station->m_state = state;
   station->m_rssiAndUpdateTimePair = std::make_pair (0, Seconds (0));
-  const_cast<WifiRemoteStationManager *> (this)->m_stations.push_back (station);
+  const_cast<WifiRemoteStationManager *> (this)->m_stations.insert ({address, station});
   return station;
 }
 
@@ -1458,14 +1449,14 @@ void
 WifiRemoteStationManager::Reset (void)
 {
   NS_LOG_FUNCTION (this);
-  for (StationStates::const_iterator i = m_states.begin (); i != m_states.end (); i++)
+  for (const auto & state : m_states)
     {
-      delete (*i);
+      delete state.second;
     }
   m_states.clear ();
-  for (Stations::const_iterator i = m_stations.begin (); i != m_stations.end (); i++)
+  for (const auto & station : m_stations)
     {
-      delete (*i);
+      delete station.second;
     }
   m_stations.clear ();
   m_bssBasicRateSet.clear ();
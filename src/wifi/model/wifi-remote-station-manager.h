@@ -22,6 +22,7 @@
 #define WIFI_REMOTE_STATION_MANAGER_H
 
 #include <array>
+#include <unordered_map>
 #include "ns3/traced-callback.h"
 #include "ns3/object.h"
 #include "ns3/data-rate.h"
@@ -134,13 +135,13 @@ public:
   };
 
   /**
-   * A vector of WifiRemoteStations
+   * A hash table of WifiRemoteStations indexed by MAC address
    */
-  typedef std::vector <WifiRemoteStation *> Stations;
+  typedef std::unordered_map <Mac48Address, WifiRemoteStation *, WifiAddressHash> Stations;
   /**
-   * A vector of WifiRemoteStationStates
+   * A hash table of WifiRemoteStationStates indexed by MAC address
    */
-  typedef std::vector <WifiRemoteStationState *> StationStates;
+  typedef std::unordered_map <Mac48Address, WifiRemoteStationState *, WifiAddressHash> StationStates;
 
   /**
    * Set up PHY associated with this device since it is the object that
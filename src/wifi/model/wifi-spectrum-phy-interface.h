@@ -61,6 +61,7 @@ public:
   Ptr<const SpectrumModel> GetRxSpectrumModel () const override;
   Ptr<AntennaModel> GetRxAntenna () const override;
   void StartRx (Ptr<SpectrumSignalParameters> params) override;
+  bool IsSharedPsdSupported (void) const override;
 
 
 private:
@@ -19,6 +19,7 @@
  *          Sébastien Deronne <sebastien.deronne@gmail.com>
  */
 
+#include <algorithm>
 #include "ns3/log.h"
 #include "yans-error-rate-model.h"
 #include "wifi-utils.h"
@@ -178,6 +179,61 @@ YansErrorRateModel::GetFecQamBer (double snr, uint64_t nbits,
   return pms;
 }
 
+YansErrorRateModel::FecParameters
+YansErrorRateModel::GetFecParameters (WifiMode mode)
+{
+  uint16_t constellationSize = mode.GetConstellationSize ();
+  WifiCodeRate codeRate = mode.GetCodeRate ();
+  if (constellationSize == 2)
+    {
+      if (codeRate == WIFI_CODE_RATE_1_2)
+        {
+          return {2, 10, 11, 0};
+        }
+      return {2, 5, 8, 0};
+    }
+  else if (constellationSize == 4 || constellationSize == 16)
+    {
+      if (codeRate == WIFI_CODE_RATE_1_2)
+        {
+          return {constellationSize, 10, 11, 0};
+        }
+      return {constellationSize, 5, 8, 31};
+    }
+  else if (constellationSize == 64)
+    {
+      if (codeRate == WIFI_CODE_RATE_2_3)
+        {
+          return {64, 6, 1, 16};
+        }
+      if (codeRate == WIFI_CODE_RATE_5_6)
+        {
+          //Table B.32  in Pâl Frenger et al., "Multi-rate Convolutional Codes".
+          return {64, 4, 14, 69};
+        }
+      return {64, 5, 8, 31};
+    }
+  else if (constellationSize == 256 || constellationSize == 1024)
+    {
+      if (codeRate == WIFI_CODE_RATE_5_6)
+        {
+          return {constellationSize, 4, 14, 69};
+        }
+      return {constellationSize, 5, 8, 31};
+    }
+  return {0, 0, 0, 0};
+}
+
+uint64_t
+YansErrorRateModel::GetEbNoPhyRate (WifiMode mode, const WifiTxVector& txVector, uint16_t staId)
+{
+  if ((mode != txVector.GetMode ()) || (txVector.IsMu () && (staId == SU_STA_ID)))
+    {
+      return mode.GetPhyRate (txVector.GetChannelWidth () >= 40 ? 20 : txVector.GetChannelWidth ()); //This is the PHY header
+    }
+  return mode.GetPhyRate (txVector, staId);
+}
+
 double
 YansErrorRateModel::DoGetChunkSuccessRate (WifiMode mode, const WifiTxVector& txVector, double snr, uint64_t nbits, uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const
 {
@@ -188,179 +244,117 @@ YansErrorRateModel::DoGetChunkSuccessRate (WifiMode mode, const WifiTxVector& tx
       || mode.GetModulationClass () == WIFI_MOD_CLASS_VHT
       || mode.GetModulationClass () == WIFI_MOD_CLASS_HE)
     {
-      uint64_t phyRate;
-      if ((mode != txVector.GetMode ()) || (txVector.IsMu () && (staId == SU_STA_ID)))
+      FecParameters fec = GetFecParameters (mode);
+      uint64_t phyRate = GetEbNoPhyRate (mode, txVector, staId);
+      if (fec.m == 2)
         {
-          phyRate = mode.GetPhyRate (txVector.GetChannelWidth () >= 40 ? 20 : txVector.GetChannelWidth ()); //This is the PHY header
+          return GetFecBpskBer (snr,
+                                nbits,
+                                txVector.GetChannelWidth () * 1000000, //signal spread
+                                phyRate, //PHY rate
+                                fec.dFree,
+                                fec.adFree);
         }
-      else
+      else if (fec.m != 0)
         {
-          phyRate = mode.GetPhyRate (txVector, staId);
+          return GetFecQamBer (snr,
+                               nbits,
+                               txVector.GetChannelWidth () * 1000000, //signal spread
+                               phyRate, //PHY rate
+                               fec.m,
+                               fec.dFree,
+                               fec.adFree,
+                               fec.adFreePlusOne);
         }
-      if (mode.GetConstellationSize () == 2)
-        {
-          if (mode.GetCodeRate () == WIFI_CODE_RATE_1_2)
-            {
-              return GetFecBpskBer (snr,
-                                    nbits,
-                                    txVector.GetChannelWidth () * 1000000, //signal spread
-                                    phyRate, //PHY rate
-                                    10, //dFree
-                                    11); //adFree
-            }
-          else
-            {
-              return GetFecBpskBer (snr,
-                                    nbits,
-                                    txVector.GetChannelWidth () * 1000000, //signal spread
-                                    phyRate, //PHY rate
-                                    5, //dFree
-                                    8); //adFree
-            }
-        }
-      else if (mode.GetConstellationSize () == 4)
+    }
+  return 0;
+}
+
+void
+YansErrorRateModel::DoGetChunkSuccessRates (WifiMode mode, const WifiTxVector& txVector, const std::vector<double>& snrs,
+                                            const std::vector<uint64_t>& nbits, std::vector<double>& successRates,
+                                            uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const
+{
+  NS_LOG_FUNCTION (this << mode << txVector << snrs.size () << +numRxAntennas << field << staId);
+  FecParameters fec = GetFecParameters (mode);
+  if ((mode.GetModulationClass () != WIFI_MOD_CLASS_ERP_OFDM
+       && mode.GetModulationClass () != WIFI_MOD_CLASS_OFDM
+       && mode.GetModulationClass () != WIFI_MOD_CLASS_HT
+       && mode.GetModulationClass () != WIFI_MOD_CLASS_VHT
+       && mode.GetModulationClass () != WIFI_MOD_CLASS_HE)
+      || fec.m == 0)
+    {
+      std::fill (successRates.begin (), successRates.end (), 0.0);
+      return;
+    }
+  uint64_t phyRate = GetEbNoPhyRate (mode, txVector, staId);
+  uint32_t signalSpread = txVector.GetChannelWidth () * 1000000;
+  double log2m = log2 (fec.m);
+  double qamFactor = 1.0 - 1.0 / std::sqrt (fec.m);
+
+  // pmu is the sum over t and k of weights[t][k] * ber^k * (1 - ber)^(dFree + t - k),
+  // where weights[t] are the terms of CalculatePd for d = dFree + t, multiplied
+  // by adFree (t = 0) or adFreePlusOne (t = 1, QAM only)
+  const unsigned int maxD = 12;
+  NS_ASSERT (fec.dFree + 1 < maxD);
+  double weights[2][maxD] = {};
+  for (unsigned int t = 0; t < 2; t++)
+    {
+      unsigned int d = fec.dFree + t;
+      double ad = (t == 0) ? fec.adFree : (fec.m == 2 ? 0 : fec.adFreePlusOne);
+      double binomial = 1.0;
+      for (unsigned int k = 0; k < d; k++)
         {
-          if (mode.GetCodeRate () == WIFI_CODE_RATE_1_2)
+          if (2 * k > d)
             {
-              return GetFecQamBer (snr,
-                                   nbits,
-                                   txVector.GetChannelWidth () * 1000000, //signal spread
-                                   phyRate, //PHY rate
-                                   4, //m
-                                   10, //dFree
-                                   11, //adFree
-                                   0); //adFreePlusOne
+              weights[t][k] = ad * binomial;
             }
-          else
+          else if (2 * k == d)
             {
-              return GetFecQamBer (snr,
-                                   nbits,
-                                   txVector.GetChannelWidth () * 1000000, //signal spread
-                                   phyRate, //PHY rate
-                                   4, //m
-                                   5, //dFree
-                                   8, //adFree
-                                   31); //adFreePlusOne
+              weights[t][k] = 0.5 * ad * binomial;
             }
+          binomial = binomial * (d - k) / (k + 1);
         }
-      else if (mode.GetConstellationSize () == 16)
+    }
+
+  for (std::size_t i = 0; i < snrs.size (); i++)
+    {
+      // same operations as GetBpskBer and GetQamBer
+      double EbNo = snrs[i] * signalSpread / phyRate;
+      double ber;
+      if (fec.m == 2)
         {
-          if (mode.GetCodeRate () == WIFI_CODE_RATE_1_2)
-            {
-              return GetFecQamBer (snr,
-                                   nbits,
-                                   txVector.GetChannelWidth () * 1000000, //signal spread
-                                   phyRate, //PHY rate
-                                   16, //m
-                                   10, //dFree
-                                   11, //adFree
-                                   0); //adFreePlusOne
-            }
-          else
-            {
-              return GetFecQamBer (snr,
-                                   nbits,
-                                   txVector.GetChannelWidth () * 1000000, //signal spread
-                                   phyRate, //PHY rate
-                                   16, //m
-                                   5, //dFree
-                                   8, //adFree
-                                   31); //adFreePlusOne
-            }
+          ber = 0.5 * erfc (std::sqrt (EbNo));
         }
-      else if (mode.GetConstellationSize () == 64)
+      else
         {
-          if (mode.GetCodeRate () == WIFI_CODE_RATE_2_3)
-            {
-              return GetFecQamBer (snr,
-                                   nbits,
-                                   txVector.GetChannelWidth () * 1000000, //signal spread
-                                   phyRate, //PHY rate
-                                   64, //m
-                                   6, //dFree
-                                   1, //adFree
-                                   16); //adFreePlusOne
-            }
-          if (mode.GetCodeRate () == WIFI_CODE_RATE_5_6)
-            {
-              //Table B.32  in Pâl Frenger et al., "Multi-rate Convolutional Codes".
-              return GetFecQamBer (snr,
-                                   nbits,
-                                   txVector.GetChannelWidth () * 1000000, //signal spread
-                                   phyRate, //PHY rate
-                                   64, //m
-                                   4, //dFree
-                                   14, //adFree
-                                   69); //adFreePlusOne
-            }
-          else
-            {
-              return GetFecQamBer (snr,
-                                   nbits,
-                                   txVector.GetChannelWidth () * 1000000, //signal spread
-                                   phyRate, //PHY rate
-                                   64, //m
-                                   5, //dFree
-                                   8, //adFree
-                                   31); //adFreePlusOne
-            }
+          double z = std::sqrt ((1.5 * log2m * EbNo) / (fec.m - 1.0));
+          double z1 = qamFactor * erfc (z);
+          ber = (1 - (1 - z1) * (1 - z1)) / log2m;
         }
-      else if (mode.GetConstellationSize () == 256)
+      double berPowers[maxD + 1];
+      double oneMinusBerPowers[maxD + 1];
+      berPowers[0] = 1.0;
+      oneMinusBerPowers[0] = 1.0;
+      for (unsigned int k = 1; k <= fec.dFree + 1; k++)
         {
-          if (mode.GetCodeRate () == WIFI_CODE_RATE_5_6)
-            {
-              return GetFecQamBer (snr,
-                                   nbits,
-                                   txVector.GetChannelWidth () * 1000000, // signal spread
-                                   phyRate, //PHY rate
-                                   256, // m
-                                   4,  // dFree
-                                   14,  // adFree
-                                   69  // adFreePlusOne
-                                   );
-            }
-          else
-            {
-              return GetFecQamBer (snr,
-                                   nbits,
-                                   txVector.GetChannelWidth () * 1000000, // signal spread
-                                   phyRate, //PHY rate
-                                   256, // m
-                                   5,  // dFree
-                                   8,  // adFree
-                                   31  // adFreePlusOne
-                                   );
-            }
+          berPowers[k] = berPowers[k - 1] * ber;
+          oneMinusBerPowers[k] = oneMinusBerPowers[k - 1] * (1 - ber);
         }
-      else if (mode.GetConstellationSize () == 1024)
+      double pmu = 0;
+      for (unsigned int t = 0; t < 2; t++)
         {
-          if (mode.GetCodeRate () == WIFI_CODE_RATE_5_6)
+          unsigned int d = fec.dFree + t;
+          for (unsigned int k = d / 2; k < d; k++)
             {
-              return GetFecQamBer (snr,
-                                   nbits,
-                                   txVector.GetChannelWidth () * 1000000, // signal spread
-                                   phyRate, //PHY rate
-                                   1024, // m
-                                   4,  // dFree
-                                   14,  // adFree
-                                   69  // adFreePlusOne
-                                   );
-            }
-          else
-            {
-              return GetFecQamBer (snr,
-                                   nbits,
-                                   txVector.GetChannelWidth () * 1000000, // signal spread
-                                   phyRate, //PHY rate
-                                   1024, // m
-                                   5,  // dFree
-                                   8,  // adFree
-                                   31  // adFreePlusOne
-                                   );
+              pmu += weights[t][k] * berPowers[k] * oneMinusBerPowers[d - k];
             }
         }
+      pmu = std::min (pmu, 1.0);
+      // (1 - pmu)^nbits, with log1p preserving the accuracy of small pmu
+      double successRate = (nbits[i] == 0) ? 1.0 : std::exp (nbits[i] * std::log1p (-pmu));
+      successRates[i] = (ber == 0.0) ? 1.0 : successRate;
     }
-  return 0;
 }
 
 } //namespace ns3
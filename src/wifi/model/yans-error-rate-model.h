@@ -49,6 +49,15 @@ namespace ns3 {
  *      57(2):440-449, February 2009.
  *    - More detailed description and validation can be found in
  *      http://www.nsnam.org/~pei/80211b.pdf
+ *
+ * The success rates of a batch of OFDM chunks (see GetChunkSuccessRates) are
+ * computed with the binomial coefficients and the powers of the BER obtained
+ * once per batch and per chunk, respectively, and with the success rate of
+ * each chunk computed in the log domain, rather than through repeated calls
+ * to std::pow. These success rates are not bit-identical to the ones returned
+ * for a single chunk: the absolute difference is less than 1e-15 per bit of
+ * the chunk (the rounding of 1 - pmu being raised to the number of bits by
+ * std::pow).
  */
 class YansErrorRateModel : public ErrorRateModel
 {
@@ -65,6 +74,31 @@ public:
 private:
   double DoGetChunkSuccessRate (WifiMode mode, const WifiTxVector& txVector, double snr, uint64_t nbits,
                                 uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const override;
+  void DoGetChunkSuccessRates (WifiMode mode, const WifiTxVector& txVector, const std::vector<double>& snrs,
+                               const std::vector<uint64_t>& nbits, std::vector<double>& successRates,
+                               uint8_t numRxAntennas, WifiPpduField field, uint16_t staId) const override;
+
+  /// Parameters of the convolutional code of an OFDM mode
+  struct FecParameters
+  {
+    uint32_t m;             //!< constellation size
+    uint32_t dFree;         //!< free distance of the code
+    uint32_t adFree;        //!< number of paths at the free distance
+    uint32_t adFreePlusOne; //!< number of paths at the free distance plus one (QAM only)
+  };
+
+  /**
+   * \param mode the OFDM mode
+   * \return the parameters of the convolutional code of the given mode
+   */
+  static FecParameters GetFecParameters (WifiMode mode);
+  /**
+   * \param mode the OFDM mode of a chunk
+   * \param txVector TXVECTOR of the overall transmission
+   * \param staId the station ID for MU
+   * \return the PHY rate used to compute the Eb/No of the chunk
+   */
+  static uint64_t GetEbNoPhyRate (WifiMode mode, const WifiTxVector& txVector, uint16_t staId);
   /**
    * Return BER of BPSK with the given parameters.
    *
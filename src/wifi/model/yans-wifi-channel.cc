@@ -18,14 +18,20 @@
  * Author: Mathieu Lacage, <mathieu.lacage@sophia.inria.fr>
  */
 
+#include <limits>
+#include <numeric>
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/abort.h"
 #include "ns3/pointer.h"
+#include "ns3/double.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/propagation-delay-model.h"
 #include "ns3/mobility-model.h"
+#include "ns3/constant-position-mobility-model.h"
+#include "ns3/grid-spatial-index.h"
 #include "yans-wifi-channel.h"
 #include "yans-wifi-phy.h"
 #include "wifi-utils.h"
@@ -53,11 +59,22 @@ YansWifiChannel::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&YansWifiChannel::m_delay),
                    MakePointerChecker<PropagationDelayModel> ())
+    .AddAttribute ("MaxRange",
+                   "The maximum distance (m) between the sender and the receivers of a PPDU. "
+                   "If set, the receivers are looked up in a spatial index and the propagation "
+                   "models are not evaluated for the receivers that are farther away. "
+                   "The results are unchanged provided that the range is large enough for "
+                   "the signals to be below the RX sensitivity beyond it and that the "
+                   "propagation models are deterministic.",
+                   DoubleValue (std::numeric_limits<double>::infinity ()),
+                   MakeDoubleAccessor (&YansWifiChannel::m_maxRange),
+                   MakeDoubleChecker<double> (0, std::numeric_limits<double>::infinity ()))
   ;
   return tid;
 }
 
 YansWifiChannel::YansWifiChannel ()
+  : m_nPartitions (1)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -88,42 +105,150 @@ YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
   NS_LOG_FUNCTION (this << sender << ppdu << txPowerDbm);
   Ptr<MobilityModel> senderMobility = sender->GetMobility ();
   NS_ASSERT (senderMobility != 0);
-  for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
+  bool partitioned = Simulator::GetLookahead ().IsStrictlyPositive ();
+  if (!partitioned && m_maxRange == std::numeric_limits<double>::infinity ())
     {
-      if (sender != (*i))
+      for (PhyList::const_iterator i = m_phyList.begin (); i != m_phyList.end (); i++)
         {
-          //For now don't account for inter channel interference nor channel bonding
-          if ((*i)->GetChannelNumber () != sender->GetChannelNumber ())
-            {
-              continue;
-            }
+          Send (sender, senderMobility, *i, ppdu, txPowerDbm);
+        }
+      return;
+    }
+  if (partitioned && m_partitions.size () != m_phyList.size ())
+    {
+      NS_FATAL_ERROR ("YansWifiChannel::PreparePartitions must be called after attaching all the PHYs");
+    }
 
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->GetObject<MobilityModel> ();
-          Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
-          double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
-          NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
-                        "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
-          Ptr<WifiPpdu> copy = ppdu->Copy ();
-          Ptr<NetDevice> dstNetDevice = (*i)->GetDevice ();
-          uint32_t dstNode;
-          if (dstNetDevice == 0)
+  // Only look at the PHYs that may be in range of the sender, in the order
+  // they were added to the channel (i.e., the order of the full list)
+  static thread_local std::vector<uint32_t> candidates;
+  Vector senderPosition = senderMobility->GetPosition ();
+  if (m_maxRange == std::numeric_limits<double>::infinity ())
+    {
+      candidates.resize (m_phyList.size ());
+      std::iota (candidates.begin (), candidates.end (), 0);
+    }
+  else
+    {
+      if (!m_index || m_index->GetN () != m_phyList.size () || m_index->GetCellSize () != m_maxRange)
+        {
+          // the index of a partitioned channel is built by PreparePartitions
+          NS_ASSERT (!partitioned);
+          m_index = Create<GridSpatialIndex> (m_maxRange);
+          for (const auto & phy : m_phyList)
             {
-              dstNode = 0xffffffff;
+              m_index->Add (phy->GetMobility ());
             }
-          else
+        }
+      m_index->GetCandidates (senderPosition, m_maxRange, candidates);
+    }
+
+  // the PHYs of the other partitions are not accessed by this thread
+  static thread_local std::vector<std::vector<uint32_t> > remoteReceivers;
+  uint32_t partition = partitioned ? Simulator::GetSystemId () : 0;
+  remoteReceivers.resize (std::max<std::size_t> (remoteReceivers.size (), m_nPartitions));
+  for (uint32_t id : candidates)
+    {
+      if (partitioned && m_partitions[id] != partition)
+        {
+          if (CalculateDistance (senderPosition, m_positions[id]) <= m_maxRange)
             {
-              dstNode = dstNetDevice->GetNode ()->GetId ();
+              remoteReceivers[m_partitions[id]].push_back (id);
             }
+          continue;
+        }
+      Ptr<YansWifiPhy> receiver = m_phyList[id];
+      Ptr<MobilityModel> receiverMobility = receiver->GetMobility ();
+      if (receiverMobility && CalculateDistance (senderPosition, receiverMobility->GetPosition ()) > m_maxRange)
+        {
+          continue;
+        }
+      Send (sender, senderMobility, receiver, ppdu, txPowerDbm);
+    }
+  for (uint32_t i = 0; i < m_nPartitions; i++)
+    {
+      if (!remoteReceivers[i].empty ())
+        {
+          Simulator::ScheduleWithContext (m_contexts[remoteReceivers[i].front ()], Simulator::GetLookahead (),
+                                          &YansWifiChannel::ReceiveRemote, this, ppdu->DeepCopy (), txPowerDbm,
+                                          senderPosition, sender->GetChannelNumber (), remoteReceivers[i]);
+          remoteReceivers[i].clear ();
+        }
+    }
+}
+
+void
+YansWifiChannel::Send (Ptr<YansWifiPhy> sender, Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver,
+                       Ptr<const WifiPpdu> ppdu, double txPowerDbm) const
+{
+  if (sender == receiver)
+    {
+      return;
+    }
+  //For now don't account for inter channel interference nor channel bonding
+  if (receiver->GetChannelNumber () != sender->GetChannelNumber ())
+    {
+      return;
+    }
 
-          Simulator::ScheduleWithContext (dstNode,
-                                          delay, &YansWifiChannel::Receive,
-                                          (*i), copy, rxPowerDbm);
+  Ptr<MobilityModel> receiverMobility = receiver->GetMobility ()->GetObject<MobilityModel> ();
+  Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+  double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+  NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
+                "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
+  Ptr<NetDevice> dstNetDevice = receiver->GetDevice ();
+  uint32_t dstNode;
+  if (dstNetDevice == 0)
+    {
+      dstNode = 0xffffffff;
+    }
+  else
+    {
+      dstNode = dstNetDevice->GetNode ()->GetId ();
+    }
+
+  //the PPDU is not modified by the receivers, hence it is shared by all of them
+  Simulator::ScheduleWithContext (dstNode,
+                                  delay, &YansWifiChannel::Receive,
+                                  receiver, ppdu, rxPowerDbm);
+}
+
+void
+YansWifiChannel::ReceiveRemote (Ptr<const WifiPpdu> ppdu, double txPowerDbm, Vector senderPosition,
+                                uint8_t channelNumber, std::vector<uint32_t> receivers) const
+{
+  NS_LOG_FUNCTION (this << ppdu << txPowerDbm << senderPosition << +channelNumber);
+  // the mobility model of the sender belongs to another partition
+  static thread_local Ptr<ConstantPositionMobilityModel> senderMobility = CreateObject<ConstantPositionMobilityModel> ();
+  senderMobility->SetPosition (senderPosition);
+  Time lookahead = Simulator::GetLookahead ();
+  for (uint32_t id : receivers)
+    {
+      Ptr<YansWifiPhy> receiver = m_phyList[id];
+      if (receiver->GetChannelNumber () != channelNumber)
+        {
+          continue;
+        }
+      Ptr<MobilityModel> receiverMobility = receiver->GetMobility ()->GetObject<MobilityModel> ();
+      if (CalculateDistance (senderPosition, receiverMobility->GetPosition ()) > m_maxRange)
+        {
+          continue;
+        }
+      Time delay = m_delay->GetDelay (senderMobility, receiverMobility);
+      double rxPowerDbm = m_loss->CalcRxPower (txPowerDbm, senderMobility, receiverMobility);
+      NS_LOG_DEBUG ("propagation: txPower=" << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, " <<
+                    "distance=" << senderMobility->GetDistanceFrom (receiverMobility) << "m, delay=" << delay);
+      if (delay < lookahead)
+        {
+          NS_FATAL_ERROR ("Propagation delay " << delay << " less than the lookahead " << lookahead);
         }
+      Simulator::ScheduleWithContext (m_contexts[id], delay - lookahead, &YansWifiChannel::Receive,
+                                      receiver, ppdu, rxPowerDbm);
     }
 }
 
 void
-YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<WifiPpdu> ppdu, double rxPowerDbm)
+YansWifiChannel::Receive (Ptr<YansWifiPhy> phy, Ptr<const WifiPpdu> ppdu, double rxPowerDbm)
 {
   NS_LOG_FUNCTION (phy << ppdu << rxPowerDbm);
   // Do no further processing if signal is too weak
@@ -157,6 +282,56 @@ YansWifiChannel::Add (Ptr<YansWifiPhy> phy)
   m_phyList.push_back (phy);
 }
 
+Time
+YansWifiChannel::PreparePartitions (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_partitions.clear ();
+  m_contexts.clear ();
+  m_positions.clear ();
+  m_nPartitions = 1;
+  for (const auto & phy : m_phyList)
+    {
+      Ptr<MobilityModel> mobility = phy->GetMobility ();
+      NS_ABORT_MSG_IF (mobility == 0, "The PHYs of a partitioned channel must have a mobility model");
+      m_positions.push_back (mobility->GetPosition ());
+      Ptr<NetDevice> device = phy->GetDevice ();
+      uint32_t context = (device == 0 ? 0xffffffff : device->GetNode ()->GetId ());
+      m_contexts.push_back (context);
+      m_partitions.push_back (Simulator::GetPartition (context));
+      m_nPartitions = std::max (m_nPartitions, m_partitions.back () + 1);
+    }
+  if (m_maxRange != std::numeric_limits<double>::infinity ())
+    {
+      m_index = Create<GridSpatialIndex> (m_maxRange);
+      for (const auto & phy : m_phyList)
+        {
+          m_index->Add (phy->GetMobility ());
+        }
+    }
+
+  Time lookahead = Time::Max ();
+  for (std::size_t i = 0; i < m_phyList.size (); i++)
+    {
+      for (std::size_t j = i + 1; j < m_phyList.size (); j++)
+        {
+          if (m_partitions[i] == m_partitions[j])
+            {
+              continue;
+            }
+          Ptr<MobilityModel> a = m_phyList[i]->GetMobility ();
+          Ptr<MobilityModel> b = m_phyList[j]->GetMobility ();
+          if (CalculateDistance (m_positions[i], m_positions[j]) > m_maxRange)
+            {
+              continue;
+            }
+          lookahead = std::min (lookahead, std::min (m_delay->GetDelay (a, b), m_delay->GetDelay (b, a)));
+        }
+    }
+  NS_LOG_DEBUG ("partitions=" << m_nPartitions << ", lookahead=" << lookahead);
+  return lookahead;
+}
+
 int64_t
 YansWifiChannel::AssignStreams (int64_t stream)
 {
@@ -22,6 +22,7 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/vector.h"
 
 namespace ns3 {
 
@@ -29,9 +30,11 @@ class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
 class YansWifiPhy;
+class MobilityModel;
 class Packet;
 class Time;
 class WifiPpdu;
+class GridSpatialIndex;
 
 /**
  * \brief a channel to interconnect ns3::YansWifiPhy objects.
@@ -41,6 +44,19 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * In a multithreaded simulation (see ns3::MultithreadedSimulatorImpl), the
+ * PHYs attached to a channel may belong to different partitions, once
+ * PreparePartitions has been called (e.g., by ns3::WifiPartitionHelper).
+ * A PPDU is then delivered to the PHYs of the partition of the sender as
+ * usual, and copied for each other partition, whose PHYs compute their
+ * propagation delay and RX power on their own thread, after the lookahead.
+ * This requires the positions of the PHYs to be constant during the
+ * simulation and the propagation models to be deterministic and
+ * stateless (e.g., not to cache their results nor to draw random
+ * variables), since they are used by several threads. The truncation of
+ * a PPDU, due to the sender switching off, is not propagated to the other
+ * partitions.
  */
 class YansWifiChannel : public Channel
 {
@@ -96,6 +112,17 @@ public:
    */
   int64_t AssignStreams (int64_t stream);
 
+  /**
+   * Record the partition and the context of each PHY attached to this
+   * channel, as needed to deliver the PPDUs to the PHYs of other partitions
+   * in a multithreaded simulation, and compute the lookahead of this
+   * channel. This must be called again if PHYs are attached to the channel.
+   *
+   * \return the minimum propagation delay between PHYs of different
+   *         partitions, or Time::Max () if there is a single partition
+   */
+  Time PreparePartitions (void);
+
 
 private:
   /**
@@ -112,11 +139,44 @@ private:
    * \param ppdu the PPDU being sent
    * \param txPowerDbm the TX power associated to the packet being sent (dBm)
    */
-  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<WifiPpdu> ppdu, double txPowerDbm);
+  static void Receive (Ptr<YansWifiPhy> receiver, Ptr<const WifiPpdu> ppdu, double txPowerDbm);
 
-  PhyList m_phyList;                   //!< List of YansWifiPhys connected to this YansWifiChannel
-  Ptr<PropagationLossModel> m_loss;    //!< Propagation loss model
-  Ptr<PropagationDelayModel> m_delay;  //!< Propagation delay model
+  /**
+   * Deliver a PPDU to the given YansWifiPhy, unless it is the sender or it
+   * operates on another channel.
+   *
+   * \param sender the PHY object from which the PPDU is originating
+   * \param senderMobility the mobility model of the sender
+   * \param receiver the PHY object to which the PPDU is delivered
+   * \param ppdu the PPDU to send
+   * \param txPowerDbm the TX power associated to the PPDU, in dBm
+   */
+  void Send (Ptr<YansWifiPhy> sender, Ptr<MobilityModel> senderMobility, Ptr<YansWifiPhy> receiver,
+             Ptr<const WifiPpdu> ppdu, double txPowerDbm) const;
+
+  /**
+   * Deliver a PPDU sent by a PHY of another partition to the given PHYs
+   * of the current partition, after the propagation delay minus the
+   * lookahead, which has already elapsed.
+   *
+   * \param ppdu the PPDU, copied for the current partition
+   * \param txPowerDbm the TX power associated to the PPDU, in dBm
+   * \param senderPosition the position of the sender
+   * \param channelNumber the channel number of the sender
+   * \param receivers the indices of the PHYs of the current partition
+   */
+  void ReceiveRemote (Ptr<const WifiPpdu> ppdu, double txPowerDbm, Vector senderPosition,
+                      uint8_t channelNumber, std::vector<uint32_t> receivers) const;
+
+  PhyList m_phyList;                          //!< List of YansWifiPhys connected to this YansWifiChannel
+  Ptr<PropagationLossModel> m_loss;           //!< Propagation loss model
+  Ptr<PropagationDelayModel> m_delay;         //!< Propagation delay model
+  double m_maxRange;                          //!< Maximum distance between the sender and the receivers
+  mutable Ptr<GridSpatialIndex> m_index;      //!< Spatial index of the PHYs, used if the maximum range is set
+  std::vector<uint32_t> m_partitions;         //!< Partition of each PHY, in a multithreaded simulation
+  std::vector<uint32_t> m_contexts;           //!< Context of each PHY, in a multithreaded simulation
+  std::vector<Vector> m_positions;            //!< Position of each PHY, in a multithreaded simulation
+  uint32_t m_nPartitions;                     //!< Number of partitions, in a multithreaded simulation
 };
 
 } //namespace ns3
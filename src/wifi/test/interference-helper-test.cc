@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/packet.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-mac-header.h"
+#include "ns3/wifi-utils.h"
+#include "ns3/ofdm-ppdu.h"
+#include "ns3/ofdm-phy.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("InterferenceHelperTest");
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the multimap and flat timelines of InterferenceHelper
+ * yield the same SNR, PER and CCA energy duration for randomly overlapping
+ * signals received on several bands.
+ */
+class InterferenceHelperTimelineTest : public TestCase
+{
+public:
+  InterferenceHelperTimelineTest ();
+  virtual ~InterferenceHelperTimelineTest ();
+
+private:
+  void DoRun (void) override;
+
+  /**
+   * Add a signal to both interference helpers and start receiving it
+   * if no reception is ongoing.
+   *
+   * \param size the size of the PSDU in bytes
+   * \param powerW the received power per band in watts
+   */
+  void AddSignal (uint32_t size, double powerW);
+  /**
+   * Compare the SNR measured by both interference helpers after preamble detection.
+   */
+  void CheckSnr (void);
+  /**
+   * Compare the SNR and PER computed by both interference helpers at the end
+   * of the reception, then notify the end of the reception.
+   */
+  void EndReceive (void);
+
+  InterferenceHelper m_multimap;                //!< interference helper using the multimap timeline
+  InterferenceHelper m_flat;                    //!< interference helper using the flat timeline
+  std::vector<WifiSpectrumBand> m_bands;        //!< bands
+  Ptr<Event> m_multimapEvent;                   //!< event being received by the multimap timeline
+  Ptr<Event> m_flatEvent;                       //!< event being received by the flat timeline
+  uint32_t m_receptions;                        //!< number of compared receptions
+};
+
+InterferenceHelperTimelineTest::InterferenceHelperTimelineTest ()
+  : TestCase ("Check that the flat and multimap InterferenceHelper timelines give the same results"),
+    m_receptions (0)
+{
+}
+
+InterferenceHelperTimelineTest::~InterferenceHelperTimelineTest ()
+{
+}
+
+void
+InterferenceHelperTimelineTest::AddSignal (uint32_t size, double powerW)
+{
+  WifiTxVector txVector = WifiTxVector (OfdmPhy::GetOfdmRate54Mbps (), 0, WIFI_PREAMBLE_LONG, 800, 1, 1, 0, 20, false);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  hdr.SetQosTid (0);
+  Ptr<WifiPsdu> psdu = Create<WifiPsdu> (Create<Packet> (size), hdr);
+  Ptr<WifiPpdu> ppdu = Create<OfdmPpdu> (psdu, txVector, WIFI_PHY_BAND_5GHZ, 0);
+  Time duration = WifiPhy::CalculateTxDuration (psdu->GetSize (), txVector, WIFI_PHY_BAND_5GHZ);
+
+  RxPowerWattPerChannelBand rxPowerW;
+  for (std::size_t i = 0; i < m_bands.size (); i++)
+    {
+      rxPowerW.insert ({m_bands[i], powerW / (i + 1)});
+    }
+  Ptr<Event> multimapEvent = m_multimap.Add (ppdu, txVector, duration, rxPowerW);
+  Ptr<Event> flatEvent = m_flat.Add (ppdu, txVector, duration, rxPowerW);
+
+  for (const auto & band : m_bands)
+    {
+      for (double thresholdDbm : {-82.0, -62.0})
+        {
+          NS_TEST_EXPECT_MSG_EQ (m_flat.GetEnergyDuration (DbmToW (thresholdDbm), band),
+                                 m_multimap.GetEnergyDuration (DbmToW (thresholdDbm), band),
+                                 "CCA energy duration differs between timelines");
+        }
+    }
+
+  if (m_multimapEvent == 0)
+    {
+      m_multimapEvent = multimapEvent;
+      m_flatEvent = flatEvent;
+      m_multimap.NotifyRxStart ();
+      m_flat.NotifyRxStart ();
+      Simulator::Schedule (MicroSeconds (4), &InterferenceHelperTimelineTest::CheckSnr, this);
+      Simulator::Schedule (duration, &InterferenceHelperTimelineTest::EndReceive, this);
+    }
+}
+
+void
+InterferenceHelperTimelineTest::CheckSnr (void)
+{
+  for (const auto & band : m_bands)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_flat.CalculateSnr (m_flatEvent, 20, 1, band),
+                             m_multimap.CalculateSnr (m_multimapEvent, 20, 1, band),
+                             "SNR differs between timelines");
+    }
+}
+
+void
+InterferenceHelperTimelineTest::EndReceive (void)
+{
+  WifiTxVector txVector = m_multimapEvent->GetTxVector ();
+  Time payloadDuration = m_multimapEvent->GetDuration () - WifiPhy::CalculatePhyPreambleAndHeaderDuration (txVector);
+  for (const auto & band : m_bands)
+    {
+      PhyEntity::SnrPer multimap = m_multimap.CalculatePhyHeaderSnrPer (m_multimapEvent, 20, band, WIFI_PPDU_FIELD_NON_HT_HEADER);
+      PhyEntity::SnrPer flat = m_flat.CalculatePhyHeaderSnrPer (m_flatEvent, 20, band, WIFI_PPDU_FIELD_NON_HT_HEADER);
+      NS_TEST_EXPECT_MSG_EQ (flat.snr, multimap.snr, "PHY header SNR differs between timelines");
+      NS_TEST_EXPECT_MSG_EQ (flat.per, multimap.per, "PHY header PER differs between timelines");
+
+      for (const auto & window : {std::make_pair (Time (0), payloadDuration),
+                                  std::make_pair (payloadDuration / 2, payloadDuration)})
+        {
+          multimap = m_multimap.CalculatePayloadSnrPer (m_multimapEvent, 20, band, SU_STA_ID, window);
+          flat = m_flat.CalculatePayloadSnrPer (m_flatEvent, 20, band, SU_STA_ID, window);
+          NS_TEST_EXPECT_MSG_EQ (flat.snr, multimap.snr, "Payload SNR differs between timelines");
+          NS_TEST_EXPECT_MSG_EQ (flat.per, multimap.per, "Payload PER differs between timelines");
+        }
+    }
+  m_multimap.NotifyRxEnd (Simulator::Now ());
+  m_flat.NotifyRxEnd (Simulator::Now ());
+  m_multimapEvent = 0;
+  m_flatEvent = 0;
+  m_receptions++;
+}
+
+void
+InterferenceHelperTimelineTest::DoRun (void)
+{
+  m_bands = {{0, 0}, {1, 1}, {2, 3}};
+  // Bands are added before the timeline type is selected to check that
+  // they are carried over to the flat timeline
+  for (auto helper : {&m_multimap, &m_flat})
+    {
+      for (const auto & band : m_bands)
+        {
+          helper->AddBand (band);
+        }
+      helper->SetNoiseFigure (DbToRatio (7));
+      helper->SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+    }
+  m_flat.SetTimelineType (InterferenceHelper::TIMELINE_FLAT);
+  NS_TEST_ASSERT_MSG_EQ (m_flat.GetTimelineType (), InterferenceHelper::TIMELINE_FLAT, "Unexpected timeline type");
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  random->SetStream (1);
+  Time start = Seconds (0);
+  for (uint32_t i = 0; i < 2000; i++)
+    {
+      start += MicroSeconds (random->GetInteger (0, 200));
+      uint32_t size = random->GetInteger (100, 1500);
+      double powerW = DbmToW (random->GetValue (-90, -40));
+      Simulator::Schedule (start, &InterferenceHelperTimelineTest::AddSignal, this, size, powerW);
+    }
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_GT (m_receptions, 100, "Too few receptions compared");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Interference Helper Test Suite
+ */
+class InterferenceHelperTestSuite : public TestSuite
+{
+public:
+  InterferenceHelperTestSuite ();
+};
+
+InterferenceHelperTestSuite::InterferenceHelperTestSuite ()
+  : TestSuite ("wifi-interference-helper", UNIT)
+{
+  AddTestCase (new InterferenceHelperTimelineTest, TestCase::QUICK);
+}
+
+static InterferenceHelperTestSuite interferenceHelperTestSuite; ///< the test suite
@@ -642,6 +642,60 @@ SpectrumWifiPhyFilterTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the band powers computed by WifiSpectrumValueHelper::GetBandPowerW
+ * match the integrals of the received PSD filtered by the RF filters
+ * returned by WifiSpectrumValueHelper::CreateRfFilter.
+ */
+class SpectrumWifiPhyBandPowerTest : public TestCase
+{
+public:
+  SpectrumWifiPhyBandPowerTest ();
+  virtual ~SpectrumWifiPhyBandPowerTest ();
+
+private:
+  void DoRun (void) override;
+};
+
+SpectrumWifiPhyBandPowerTest::SpectrumWifiPhyBandPowerTest ()
+  : TestCase ("SpectrumWifiPhy test band power integration")
+{
+}
+
+SpectrumWifiPhyBandPowerTest::~SpectrumWifiPhyBandPowerTest ()
+{
+}
+
+void
+SpectrumWifiPhyBandPowerTest::DoRun (void)
+{
+  const uint32_t bandBandwidth = 78125; // Hz
+  for (const auto & freqWidthPair : std::vector<std::pair<uint16_t, uint16_t>> {{5180, 20}, {5190, 40}, {5210, 80}, {5250, 160}})
+    {
+      uint16_t channelWidth = freqWidthPair.second;
+      Ptr<SpectrumValue> psd = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (freqWidthPair.first, channelWidth,
+                                                                                             DbmToW (16), channelWidth);
+      std::size_t numBands = psd->GetSpectrumModel ()->GetNumBands ();
+      for (std::size_t width = 1; width <= numBands; width = width * 2 + 1)
+        {
+          for (std::size_t start = 0; start + width <= numBands; start += width / 2 + 1)
+            {
+              WifiSpectrumBand band = std::make_pair (start, start + width - 1);
+              Ptr<SpectrumValue> filter = WifiSpectrumValueHelper::CreateRfFilter (freqWidthPair.first, channelWidth,
+                                                                                   bandBandwidth, channelWidth, band);
+              double expected = Integral ((*filter) * (*psd));
+              // allow for rounding differences (e.g. due to fused multiply-add)
+              NS_TEST_ASSERT_MSG_EQ_TOL (WifiSpectrumValueHelper::GetBandPowerW (psd, band), expected, expected * 1e-12,
+                                     "Band power differs from the integral of the filtered PSD for band ("
+                                     << band.first << ";" << band.second << ") of a " << channelWidth << " MHz channel");
+            }
+        }
+    }
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -660,6 +714,7 @@ SpectrumWifiPhyTestSuite::SpectrumWifiPhyTestSuite ()
   AddTestCase (new SpectrumWifiPhyBasicTest, TestCase::QUICK);
   AddTestCase (new SpectrumWifiPhyListenerTest, TestCase::QUICK);
   AddTestCase (new SpectrumWifiPhyFilterTest, TestCase::QUICK);
+  AddTestCase (new SpectrumWifiPhyBandPowerTest, TestCase::QUICK);
 }
 
 static SpectrumWifiPhyTestSuite spectrumWifiPhyTestSuite; ///< the test suite
@@ -0,0 +1,258 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <map>
+#include <limits>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/config.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+#include "ns3/pointer.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/spectrum-wifi-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/packet.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("WifiChannelMaxRangeTest");
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that setting a maximum range, beyond which signals are below
+ * the RX sensitivity, on a YansWifiChannel or a MultiModelSpectrumChannel
+ * does not change the frames received by the PHYs.
+ */
+class WifiChannelMaxRangeTest : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param spectrum whether to use a MultiModelSpectrumChannel (rather than a YansWifiChannel)
+   */
+  WifiChannelMaxRangeTest (bool spectrum);
+  virtual ~WifiChannelMaxRangeTest ();
+
+private:
+  void DoRun (void) override;
+
+  /// Counters of the PHY events of a device
+  struct PhyCounters
+  {
+    uint32_t rxBegin; ///< number of PhyRxBegin events
+    uint32_t rxEnd;   ///< number of PhyRxEnd events
+    uint32_t rxDrop;  ///< number of PhyRxDrop events
+  };
+
+  /// PHY counters indexed by trace context
+  typedef std::map<std::string, PhyCounters> CountersMap;
+
+  /**
+   * Run a simulation
+   *
+   * \param maxRange the maximum range of the channel
+   */
+  void RunSimulation (double maxRange);
+  /**
+   * PHY RX begin trace sink
+   * \param context the context
+   * \param p the packet
+   * \param rxPowersW the received power per band
+   */
+  void PhyRxBegin (std::string context, Ptr<const Packet> p, RxPowerWattPerChannelBand rxPowersW);
+  /**
+   * PHY RX end trace sink
+   * \param context the context
+   * \param p the packet
+   */
+  void PhyRxEnd (std::string context, Ptr<const Packet> p);
+  /**
+   * PHY RX drop trace sink
+   * \param context the context
+   * \param p the packet
+   * \param reason the reason
+   */
+  void PhyRxDrop (std::string context, Ptr<const Packet> p, WifiPhyRxfailureReason reason);
+
+  bool m_spectrum;        ///< whether to use a MultiModelSpectrumChannel
+  CountersMap m_counters; ///< PHY counters of the current simulation
+};
+
+WifiChannelMaxRangeTest::WifiChannelMaxRangeTest (bool spectrum)
+  : TestCase (std::string ("Check that a conservative maximum range does not change receptions on a ")
+              + (spectrum ? "MultiModelSpectrumChannel" : "YansWifiChannel")),
+    m_spectrum (spectrum)
+{
+}
+
+WifiChannelMaxRangeTest::~WifiChannelMaxRangeTest ()
+{
+}
+
+void
+WifiChannelMaxRangeTest::PhyRxBegin (std::string context, Ptr<const Packet> p, RxPowerWattPerChannelBand rxPowersW)
+{
+  m_counters[context.substr (0, context.rfind ('/'))].rxBegin++;
+}
+
+void
+WifiChannelMaxRangeTest::PhyRxEnd (std::string context, Ptr<const Packet> p)
+{
+  m_counters[context.substr (0, context.rfind ('/'))].rxEnd++;
+}
+
+void
+WifiChannelMaxRangeTest::PhyRxDrop (std::string context, Ptr<const Packet> p, WifiPhyRxfailureReason reason)
+{
+  m_counters[context.substr (0, context.rfind ('/'))].rxDrop++;
+}
+
+void
+WifiChannelMaxRangeTest::RunSimulation (double maxRange)
+{
+  m_counters.clear ();
+  uint32_t nNodes = 60;
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  Ptr<LogDistancePropagationLossModel> loss = CreateObject<LogDistancePropagationLossModel> ();
+  Ptr<ConstantSpeedPropagationDelayModel> delay = CreateObject<ConstantSpeedPropagationDelayModel> ();
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices;
+  if (m_spectrum)
+    {
+      Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+      channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+      channel->AddPropagationLossModel (loss);
+      channel->SetPropagationDelayModel (delay);
+      SpectrumWifiPhyHelper phy;
+      phy.SetChannel (channel);
+      devices = wifi.Install (phy, mac, nodes);
+    }
+  else
+    {
+      Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+      channel->SetAttribute ("MaxRange", DoubleValue (maxRange));
+      channel->SetPropagationLossModel (loss);
+      channel->SetPropagationDelayModel (delay);
+      YansWifiPhyHelper phy;
+      phy.SetChannel (channel);
+      devices = wifi.Install (phy, mac, nodes);
+    }
+  wifi.AssignStreams (devices, 1);
+
+  MobilityHelper mobility;
+  Ptr<RandomRectanglePositionAllocator> positions = CreateObject<RandomRectanglePositionAllocator> ();
+  positions->SetAttribute ("X", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=1000.0]"));
+  positions->SetAttribute ("Y", StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=1000.0]"));
+  positions->AssignStreams (100);
+  mobility.SetPositionAllocator (positions);
+  mobility.SetMobilityModel ("ns3::ConstantVelocityMobilityModel");
+  mobility.Install (nodes);
+  for (uint32_t i = 0; i < nNodes; i += 5)
+    {
+      // a few nodes move across cells
+      nodes.Get (i)->GetObject<ConstantVelocityMobilityModel> ()->SetVelocity (Vector (100, -50, 0));
+    }
+
+  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxBegin",
+                   MakeCallback (&WifiChannelMaxRangeTest::PhyRxBegin, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxEnd",
+                   MakeCallback (&WifiChannelMaxRangeTest::PhyRxEnd, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxDrop",
+                   MakeCallback (&WifiChannelMaxRangeTest::PhyRxDrop, this));
+
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      Ptr<NetDevice> device = devices.Get (i);
+      for (uint32_t j = 0; j < 3; j++)
+        {
+          // frames are sent in bursts so that some of them overlap
+          Simulator::Schedule (MilliSeconds (j * 500 + (i % 20) * 20), &NetDevice::Send, device,
+                               Create<Packet> (500), device->GetBroadcast (), 0x88b5);
+        }
+    }
+
+  Simulator::Stop (Seconds (2));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+void
+WifiChannelMaxRangeTest::DoRun (void)
+{
+  RunSimulation (std::numeric_limits<double>::infinity ());
+  CountersMap reference = m_counters;
+  // With the default models and parameters, signals are below the RX
+  // sensitivity beyond ~220 m
+  RunSimulation (300);
+
+  NS_TEST_ASSERT_MSG_EQ (m_counters.size (), reference.size (), "Unexpected number of receiving PHYs");
+  uint32_t rxEnd = 0;
+  for (const auto & devCounters : reference)
+    {
+      auto it = m_counters.find (devCounters.first);
+      NS_TEST_ASSERT_MSG_EQ ((it != m_counters.end ()), true, "No reception for " << devCounters.first);
+      NS_TEST_EXPECT_MSG_EQ (it->second.rxBegin, devCounters.second.rxBegin, "Unexpected PhyRxBegin count for " << devCounters.first);
+      NS_TEST_EXPECT_MSG_EQ (it->second.rxEnd, devCounters.second.rxEnd, "Unexpected PhyRxEnd count for " << devCounters.first);
+      NS_TEST_EXPECT_MSG_EQ (it->second.rxDrop, devCounters.second.rxDrop, "Unexpected PhyRxDrop count for " << devCounters.first);
+      rxEnd += devCounters.second.rxEnd;
+    }
+  // make sure the scenario is meaningful, i.e., that frames were received
+  // and that not all nodes are within range of each other
+  NS_TEST_EXPECT_MSG_GT (rxEnd, 0, "No frame received");
+  NS_TEST_EXPECT_MSG_LT (rxEnd, 60 * 59 * 3, "All frames received by all nodes");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Wifi Channel Max Range Test Suite
+ */
+class WifiChannelMaxRangeTestSuite : public TestSuite
+{
+public:
+  WifiChannelMaxRangeTestSuite ();
+};
+
+WifiChannelMaxRangeTestSuite::WifiChannelMaxRangeTestSuite ()
+  : TestSuite ("wifi-channel-max-range", UNIT)
+{
+  AddTestCase (new WifiChannelMaxRangeTest (false), TestCase::QUICK);
+  AddTestCase (new WifiChannelMaxRangeTest (true), TestCase::QUICK);
+}
+
+static WifiChannelMaxRangeTestSuite g_wifiChannelMaxRangeTestSuite; ///< the test suite
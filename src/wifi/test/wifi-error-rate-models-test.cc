@@ -1527,6 +1527,229 @@ TableBasedErrorRateTestCase::DoRun (void)
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the lookup of the PER in the reference tables returns the
+ * same values as a linear scan of the tables, and that the batch computation
+ * of chunk success rates returns the same values as the computation of the
+ * success rate of each chunk.
+ */
+class TableBasedErrorRateLookupTestCase : public TestCase
+{
+public:
+  TableBasedErrorRateLookupTestCase ();
+  virtual ~TableBasedErrorRateLookupTestCase ();
+
+private:
+  void DoRun (void) override;
+  /**
+   * Get the PER of a table by linearly scanning it
+   *
+   * \param table the table of SNR and PER pairs
+   * \param snr the SNR (dB)
+   * \return the PER
+   */
+  static double GetLinearScanPer (const SnrPerTable &table, double snr);
+  /**
+   * Check the lookups of a set of tables
+   *
+   * \param tables the tables indexed by MCS
+   * \param nTables the number of tables
+   */
+  void CheckLookups (const SnrPerTable *tables, std::size_t nTables);
+};
+
+TableBasedErrorRateLookupTestCase::TableBasedErrorRateLookupTestCase ()
+  : TestCase ("Check the lookup of the PER in the reference tables and the batch computation of chunk success rates")
+{
+}
+
+TableBasedErrorRateLookupTestCase::~TableBasedErrorRateLookupTestCase ()
+{
+}
+
+double
+TableBasedErrorRateLookupTestCase::GetLinearScanPer (const SnrPerTable &table, double snr)
+{
+  for (auto it = table.begin (); it != table.end (); ++it)
+    {
+      if (it->first == snr)
+        {
+          return it->second;
+        }
+    }
+  if (snr < table.front ().first)
+    {
+      return 1.0;
+    }
+  if (snr > table.back ().first)
+    {
+      return 0.0;
+    }
+  double a = 0.0, b = 0.0, previousSnr = 0.0, nextSnr = 0.0;
+  for (auto it = table.begin (); it != table.end (); ++it)
+    {
+      if (it->first < snr)
+        {
+          previousSnr = it->first;
+          a = it->second;
+        }
+      else
+        {
+          nextSnr = it->first;
+          b = it->second;
+          break;
+        }
+    }
+  return a + (snr - previousSnr) * (b - a) / (nextSnr - previousSnr);
+}
+
+void
+TableBasedErrorRateLookupTestCase::CheckLookups (const SnrPerTable *tables, std::size_t nTables)
+{
+  for (std::size_t mcs = 0; mcs < nTables; mcs++)
+    {
+      const SnrPerTable &table = tables[mcs];
+      SnrPerTableLookup lookup (table);
+      // SNRs rounded to two decimals, as done by TableBasedErrorRateModel
+      for (int64_t centiDb = std::floor (table.front ().first * 100) - 100; centiDb <= std::ceil (table.back ().first * 100) + 100; centiDb++)
+        {
+          double snr = static_cast<double> (centiDb) / 100;
+          NS_TEST_EXPECT_MSG_EQ (lookup.GetPer (snr), GetLinearScanPer (table, snr),
+                                 "Unexpected PER for MCS " << mcs << " and SNR " << snr << " dB");
+        }
+    }
+}
+
+void
+TableBasedErrorRateLookupTestCase::DoRun (void)
+{
+  CheckLookups (AwgnErrorTableBcc32, ERROR_TABLE_BCC_MAX_NUM_MCS + 1);
+  CheckLookups (AwgnErrorTableBcc1458, ERROR_TABLE_BCC_MAX_NUM_MCS + 1);
+  CheckLookups (AwgnErrorTableLdpc1458, ERROR_TABLE_LDPC_MAX_NUM_MCS + 1);
+
+  Ptr<TableBasedErrorRateModel> model = CreateObject<TableBasedErrorRateModel> ();
+  std::vector<double> snrs;
+  std::vector<uint64_t> nbits;
+  for (double snrDb = -5; snrDb <= 45; snrDb += 0.37)
+    {
+      for (uint64_t size : {1, 32, 300, 1000, 1458, 3000})
+        {
+          snrs.push_back (DbToRatio (snrDb));
+          nbits.push_back (size * 8);
+        }
+    }
+  std::vector<double> successRates;
+  for (bool ldpc : {false, true})
+    {
+      for (uint8_t mcs = 0; mcs <= 11; mcs++)
+        {
+          WifiMode mode = HePhy::GetHeMcs (mcs);
+          WifiTxVector txVector;
+          txVector.SetMode (mode);
+          txVector.SetLdpc (ldpc);
+          model->GetChunkSuccessRates (mode, txVector, snrs, nbits, successRates);
+          NS_TEST_ASSERT_MSG_EQ (successRates.size (), snrs.size (), "Unexpected number of success rates");
+          for (std::size_t i = 0; i < snrs.size (); i++)
+            {
+              NS_TEST_EXPECT_MSG_EQ (successRates[i], model->GetChunkSuccessRate (mode, txVector, snrs[i], nbits[i]),
+                                     "Unexpected success rate for " << mode << " (LDPC=" << ldpc << "), SNR "
+                                     << RatioToDb (snrs[i]) << " dB and " << nbits[i] << " bits");
+            }
+        }
+    }
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the batch computation of chunk success rates of the NIST
+ * and YANS error rate models matches the computation of the success rate of
+ * each chunk within the documented tolerance, i.e., 1e-15 per bit.
+ */
+class WifiErrorRateModelsBatchTestCase : public TestCase
+{
+public:
+  WifiErrorRateModelsBatchTestCase ();
+  virtual ~WifiErrorRateModelsBatchTestCase ();
+
+private:
+  void DoRun (void) override;
+  /**
+   * Check the batch computation of an error rate model
+   *
+   * \param model the error rate model
+   * \param name the name of the error rate model
+   */
+  void CheckModel (Ptr<ErrorRateModel> model, std::string name);
+};
+
+WifiErrorRateModelsBatchTestCase::WifiErrorRateModelsBatchTestCase ()
+  : TestCase ("WifiErrorRateModel batch computation of chunk success rates")
+{
+}
+
+WifiErrorRateModelsBatchTestCase::~WifiErrorRateModelsBatchTestCase ()
+{
+}
+
+void
+WifiErrorRateModelsBatchTestCase::CheckModel (Ptr<ErrorRateModel> model, std::string name)
+{
+  std::vector<double> snrs;
+  std::vector<uint64_t> nbits;
+  for (double snrDb = -10; snrDb <= 50; snrDb += 0.29)
+    {
+      for (uint64_t size : {0, 1, 32, 1458, 65535})
+        {
+          snrs.push_back (DbToRatio (snrDb));
+          nbits.push_back (size * 8);
+        }
+    }
+  std::vector<WifiMode> modes = {OfdmPhy::GetOfdmRate6Mbps (), OfdmPhy::GetOfdmRate9Mbps (),
+                                 OfdmPhy::GetOfdmRate12Mbps (), OfdmPhy::GetOfdmRate18Mbps (),
+                                 OfdmPhy::GetOfdmRate24Mbps (), OfdmPhy::GetOfdmRate36Mbps (),
+                                 OfdmPhy::GetOfdmRate48Mbps (), OfdmPhy::GetOfdmRate54Mbps ()};
+  for (uint8_t mcs = 0; mcs <= 11; mcs++)
+    {
+      modes.push_back (HePhy::GetHeMcs (mcs));
+    }
+  std::vector<double> successRates;
+  for (const auto & mode : modes)
+    {
+      for (uint16_t channelWidth : {20, 80})
+        {
+          WifiTxVector txVector;
+          txVector.SetMode (mode);
+          txVector.SetChannelWidth (channelWidth);
+          // chunks of the payload and of the non-HT PHY header
+          for (const auto & chunkMode : {mode, OfdmPhy::GetOfdmRate6Mbps ()})
+            {
+              model->GetChunkSuccessRates (chunkMode, txVector, snrs, nbits, successRates);
+              NS_TEST_ASSERT_MSG_EQ (successRates.size (), snrs.size (), "Unexpected number of success rates");
+              for (std::size_t i = 0; i < snrs.size (); i++)
+                {
+                  double successRate = model->GetChunkSuccessRate (chunkMode, txVector, snrs[i], nbits[i]);
+                  NS_TEST_EXPECT_MSG_EQ_TOL (successRates[i], successRate, 1e-15 * std::max<uint64_t> (nbits[i], 1),
+                                             "Unexpected " << name << " success rate for " << chunkMode << " (TX mode "
+                                             << mode << ", " << channelWidth << " MHz), SNR " << RatioToDb (snrs[i])
+                                             << " dB and " << nbits[i] << " bits");
+                }
+            }
+        }
+    }
+}
+
+void
+WifiErrorRateModelsBatchTestCase::DoRun (void)
+{
+  CheckModel (CreateObject<NistErrorRateModel> (), "NIST");
+  CheckModel (CreateObject<YansErrorRateModel> (), "YANS");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1558,6 +1781,8 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite ()
   AddTestCase (new TableBasedErrorRateTestCase ("DefaultTableBasedVhtMcs0-2000bytes", VhtPhy::GetVhtMcs0 (), 2000), TestCase::QUICK);
   AddTestCase (new TableBasedErrorRateTestCase ("DefaultTableBasedVhtMcs8-1500bytes", VhtPhy::GetVhtMcs8 (), 1500), TestCase::QUICK);
   AddTestCase (new TableBasedErrorRateTestCase ("FallbackTableBasedHeMcs11-1458bytes", HePhy::GetHeMcs11 (), 1458), TestCase::QUICK);
+  AddTestCase (new TableBasedErrorRateLookupTestCase, TestCase::QUICK);
+  AddTestCase (new WifiErrorRateModelsBatchTestCase, TestCase::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite; ///< the test suite
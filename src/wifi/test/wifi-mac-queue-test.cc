@@ -21,6 +21,8 @@
 #include "ns3/test.h"
 #include "ns3/wifi-mac-queue.h"
 #include "ns3/simulator.h"
+#include "ns3/random-variable-stream.h"
+#include <functional>
 
 using namespace ns3;
 
@@ -107,6 +109,291 @@ WifiMacQueueDropOldestTest::DoRun ()
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Test the per-receiver sub-queues and the expiry index.
+ *
+ * This test performs random insertions (at the tail, at the head and in the
+ * middle of the queue) and removals of data and management frames addressed
+ * to a few receivers, while time advances and packets expire, and checks
+ * that the searches by TID and address and by address and the per-receiver
+ * packet and byte counts return the same results as a linear scan of the
+ * queue.
+ */
+class WifiMacQueueIndexTest : public TestCase
+{
+public:
+  WifiMacQueueIndexTest ();
+
+  void DoRun () override;
+
+private:
+  /**
+   * Perform a batch of random operations on the queue and check the results
+   * of the searches.
+   *
+   * \param nBatches the number of batches left
+   */
+  void RunBatch (uint32_t nBatches);
+  /**
+   * Insert a frame in the queue.
+   *
+   * \param pos the position of the frame in the queue
+   */
+  void InsertFrame (WifiMacQueue::ConstIterator pos);
+  /**
+   * \param index the index of a position in the queue
+   * \return the position having the given index
+   */
+  WifiMacQueue::ConstIterator GetPosition (uint32_t index) const;
+  /**
+   * Check the searches and the counts of all the receivers and TIDs.
+   */
+  void CheckQueue (void);
+  /**
+   * Find the first unexpired frame matching a criterion by scanning the queue.
+   *
+   * \param pos the position to start the scan from
+   * \param match the criterion
+   * \return the position of the frame, if any, or the end of the queue
+   */
+  WifiMacQueue::ConstIterator Scan (WifiMacQueue::ConstIterator pos,
+                                    std::function<bool (Ptr<const WifiMacQueueItem>)> match) const;
+  /**
+   * Count the frame removed because their lifetime expired.
+   *
+   * \param item the expired frame
+   */
+  void NotifyExpired (Ptr<const WifiMacQueueItem> item);
+
+  Ptr<WifiMacQueue> m_queue;                   //!< the queue
+  Ptr<UniformRandomVariable> m_random;         //!< the random variable
+  std::vector<Mac48Address> m_addresses;       //!< the receivers
+  uint32_t m_nExpired;                         //!< the number of expired frames
+};
+
+WifiMacQueueIndexTest::WifiMacQueueIndexTest ()
+  : TestCase ("Test the per-receiver sub-queues and the expiry index"),
+    m_nExpired (0)
+{
+}
+
+void
+WifiMacQueueIndexTest::NotifyExpired (Ptr<const WifiMacQueueItem> item)
+{
+  m_nExpired++;
+}
+
+WifiMacQueue::ConstIterator
+WifiMacQueueIndexTest::GetPosition (uint32_t index) const
+{
+  auto pos = m_queue->begin ();
+  while (index-- > 0 && pos != m_queue->end ())
+    {
+      pos++;
+    }
+  return pos;
+}
+
+void
+WifiMacQueueIndexTest::InsertFrame (WifiMacQueue::ConstIterator pos)
+{
+  WifiMacHeader header;
+  uint32_t type = m_random->GetInteger (0, 9);
+  if (type < 7)
+    {
+      header.SetType (WIFI_MAC_QOSDATA);
+      header.SetQosTid (m_random->GetInteger (0, 7));
+    }
+  else if (type < 9)
+    {
+      header.SetType (WIFI_MAC_DATA);
+    }
+  else
+    {
+      header.SetType (WIFI_MAC_MGT_ACTION);
+    }
+  header.SetAddr1 (m_addresses[m_random->GetInteger (0, m_addresses.size () - 1)]);
+  m_queue->Insert (pos, Create<WifiMacQueueItem> (Create<Packet> (m_random->GetInteger (10, 1500)), header));
+}
+
+WifiMacQueue::ConstIterator
+WifiMacQueueIndexTest::Scan (WifiMacQueue::ConstIterator pos,
+                             std::function<bool (Ptr<const WifiMacQueueItem>)> match) const
+{
+  for (auto it = pos; it != m_queue->end (); it++)
+    {
+      if (Simulator::Now () <= (*it)->GetTimeStamp () + m_queue->GetMaxDelay () && match (*it))
+        {
+          return it;
+        }
+    }
+  return m_queue->end ();
+}
+
+void
+WifiMacQueueIndexTest::CheckQueue (void)
+{
+  uint32_t size = m_queue->QueueBase::GetNPackets ();
+  for (auto & address : m_addresses)
+    {
+      for (uint8_t tid = 0; tid < 8; tid++)
+        {
+          auto match = [address, tid] (Ptr<const WifiMacQueueItem> item)
+            {
+              return item->GetHeader ().IsQosData () && item->GetHeader ().GetAddr1 () == address
+                     && item->GetHeader ().GetQosTid () == tid;
+            };
+          uint32_t index = m_random->GetInteger (0, size);
+          NS_TEST_EXPECT_MSG_EQ ((m_queue->PeekByTidAndAddress (tid, address) == Scan (m_queue->begin (), match)),
+                                 true, "Unexpected frame found by TID and address");
+          NS_TEST_EXPECT_MSG_EQ ((m_queue->PeekByTidAndAddress (tid, address, GetPosition (index))
+                                  == Scan (GetPosition (index), match)),
+                                 true, "Unexpected frame found by TID and address from position " << index);
+
+          // follow the sequence of frames returned by the searches
+          auto it = m_queue->PeekByTidAndAddress (tid, address);
+          uint32_t nPackets = 0;
+          uint32_t nBytes = 0;
+          for (auto & item : *m_queue)
+            {
+              if (match (item))
+                {
+                  nPackets++;
+                  nBytes += item->GetSize ();
+                }
+            }
+          uint32_t nFound = 0;
+          while (it != m_queue->end ())
+            {
+              auto next = m_queue->PeekByTidAndAddress (tid, address, std::next (it));
+              NS_TEST_EXPECT_MSG_EQ ((next == Scan (std::next (it), match)), true,
+                                     "Unexpected frame found by TID and address");
+              it = next;
+              nFound++;
+            }
+          NS_TEST_EXPECT_MSG_LT_OR_EQ (nFound, nPackets, "Unexpected number of frames found");
+          NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (tid, address), nPackets, "Unexpected number of packets");
+          NS_TEST_EXPECT_MSG_EQ (m_queue->GetNBytes (tid, address), nBytes, "Unexpected number of bytes");
+        }
+
+      auto match = [address] (Ptr<const WifiMacQueueItem> item)
+        {
+          return item->GetHeader ().IsData () && item->GetHeader ().GetAddr1 () == address;
+        };
+      uint32_t index = m_random->GetInteger (0, size);
+      NS_TEST_EXPECT_MSG_EQ ((m_queue->PeekByAddress (address) == Scan (m_queue->begin (), match)),
+                             true, "Unexpected frame found by address");
+      NS_TEST_EXPECT_MSG_EQ ((m_queue->PeekByAddress (address, GetPosition (index))
+                              == Scan (GetPosition (index), match)),
+                             true, "Unexpected frame found by address from position " << index);
+    }
+}
+
+void
+WifiMacQueueIndexTest::RunBatch (uint32_t nBatches)
+{
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      uint32_t size = m_queue->QueueBase::GetNPackets ();
+      uint32_t operation = m_random->GetInteger (0, 9);
+      if (operation < 3)
+        {
+          InsertFrame (m_queue->end ());
+        }
+      else if (operation < 4)
+        {
+          InsertFrame (m_queue->begin ());
+        }
+      else if (operation < 6)
+        {
+          InsertFrame (GetPosition (m_random->GetInteger (0, size)));
+        }
+      else if (operation < 7 && size > 0)
+        {
+          m_queue->Remove (GetPosition (m_random->GetInteger (0, size - 1)), m_random->GetInteger (0, 1));
+        }
+      else if (operation < 8)
+        {
+          m_queue->DequeueByTidAndAddress (m_random->GetInteger (0, 7),
+                                           m_addresses[m_random->GetInteger (0, m_addresses.size () - 1)]);
+        }
+      else if (operation < 9)
+        {
+          m_queue->DequeueByAddress (m_addresses[m_random->GetInteger (0, m_addresses.size () - 1)]);
+        }
+      else
+        {
+          uint32_t nPackets = 0;
+          for (auto & item : *m_queue)
+            {
+              if (Simulator::Now () <= item->GetTimeStamp () + m_queue->GetMaxDelay ())
+                {
+                  nPackets++;
+                }
+            }
+          if (m_random->GetInteger (0, 1) == 0)
+            {
+              m_queue->Remove (WifiMacQueue::EMPTY, true);
+              NS_TEST_EXPECT_MSG_EQ (m_queue->QueueBase::GetNPackets (), nPackets, "Expired packets not removed");
+            }
+          else
+            {
+              NS_TEST_EXPECT_MSG_EQ (m_queue->GetNPackets (), nPackets, "Expired packets not removed");
+            }
+        }
+    }
+  CheckQueue ();
+
+  if (nBatches > 1)
+    {
+      Simulator::Schedule (MilliSeconds (m_random->GetInteger (1, 5)), &WifiMacQueueIndexTest::RunBatch,
+                           this, nBatches - 1);
+    }
+}
+
+void
+WifiMacQueueIndexTest::DoRun ()
+{
+  m_random = CreateObject<UniformRandomVariable> ();
+  m_random->SetStream (1);
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      m_addresses.push_back (Mac48Address::Allocate ());
+    }
+  m_queue = CreateObject<WifiMacQueue> ();
+  m_queue->SetMaxSize (QueueSize ("100p"));
+  m_queue->SetMaxDelay (MilliSeconds (30));
+  m_queue->TraceConnectWithoutContext ("Expired", MakeCallback (&WifiMacQueueIndexTest::NotifyExpired, this));
+
+  // insert many frames at the same position, so that the queue needs to
+  // renumber its items
+  InsertFrame (m_queue->end ());
+  InsertFrame (m_queue->end ());
+  for (uint32_t i = 0; i < 40; i++)
+    {
+      InsertFrame (std::prev (m_queue->end ()));
+    }
+  CheckQueue ();
+
+  Simulator::Schedule (MilliSeconds (1), &WifiMacQueueIndexTest::RunBatch, this, 200);
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_GT (m_nExpired, 0, "Expected some frames to expire");
+  uint32_t nPackets = m_queue->GetNPackets ();
+  uint32_t nPacketsByAddress = 0;
+  for (auto & address : m_addresses)
+    {
+      nPacketsByAddress += m_queue->GetNPacketsByAddress (address);
+    }
+  NS_TEST_EXPECT_MSG_LT_OR_EQ (nPacketsByAddress, nPackets, "Unexpected number of packets by address");
+  m_queue->Dispose ();
+  m_queue = 0;
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -123,6 +410,7 @@ WifiMacQueueTestSuite::WifiMacQueueTestSuite ()
   : TestSuite ("wifi-mac-queue", UNIT)
 {
   AddTestCase (new WifiMacQueueDropOldestTest, TestCase::QUICK);
+  AddTestCase (new WifiMacQueueIndexTest, TestCase::QUICK);
 }
 
 static WifiMacQueueTestSuite g_wifiMacQueueTestSuite; ///< the test suite
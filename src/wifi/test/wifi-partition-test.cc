@@ -0,0 +1,252 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <tuple>
+#include <vector>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/wifi-partition-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/packet.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("WifiPartitionTest");
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that a wifi network partitioned among the threads of a
+ * multithreaded simulation receives the same frames as in a sequential
+ * simulation with a single sender, and that the simulation is
+ * deterministic with concurrent senders.
+ */
+class WifiPartitionTest : public TestCase
+{
+public:
+  WifiPartitionTest ();
+  virtual ~WifiPartitionTest ();
+
+private:
+  void DoRun (void) override;
+
+  /// A PHY event: time (ns), RX power (W) or 0, and type (0: RX begin, 1: RX end, 2: RX drop)
+  typedef std::tuple<int64_t, double, int> Record;
+  /// The PHY events of each node
+  typedef std::vector<std::vector<Record> > Records;
+
+  /**
+   * Run a simulation
+   *
+   * \param nPartitions the number of partitions, 0 for a sequential simulation
+   * \param allSenders whether all the nodes send frames, rather than only the first one
+   * \return the PHY events of each node
+   */
+  Records RunSimulation (uint32_t nPartitions, bool allSenders);
+  /**
+   * \param context the trace context
+   * \return the node of the trace context
+   */
+  static uint32_t GetNode (std::string context);
+  /**
+   * PHY RX begin trace sink
+   * \param context the context
+   * \param p the packet
+   * \param rxPowersW the received power per band
+   */
+  void PhyRxBegin (std::string context, Ptr<const Packet> p, RxPowerWattPerChannelBand rxPowersW);
+  /**
+   * PHY RX end trace sink
+   * \param context the context
+   * \param p the packet
+   */
+  void PhyRxEnd (std::string context, Ptr<const Packet> p);
+  /**
+   * PHY RX drop trace sink
+   * \param context the context
+   * \param p the packet
+   * \param reason the reason
+   */
+  void PhyRxDrop (std::string context, Ptr<const Packet> p, WifiPhyRxfailureReason reason);
+
+  Records m_records; ///< PHY events of the current simulation, written by the partition of each node
+};
+
+WifiPartitionTest::WifiPartitionTest ()
+  : TestCase ("Check the receptions of a YansWifiChannel shared by several partitions")
+{
+}
+
+WifiPartitionTest::~WifiPartitionTest ()
+{
+}
+
+uint32_t
+WifiPartitionTest::GetNode (std::string context)
+{
+  std::size_t start = std::string ("/NodeList/").size ();
+  return std::stoul (context.substr (start, context.find ('/', start) - start));
+}
+
+void
+WifiPartitionTest::PhyRxBegin (std::string context, Ptr<const Packet> p, RxPowerWattPerChannelBand rxPowersW)
+{
+  m_records[GetNode (context)].push_back (std::make_tuple (Simulator::Now ().GetNanoSeconds (),
+                                                           rxPowersW.begin ()->second, 0));
+}
+
+void
+WifiPartitionTest::PhyRxEnd (std::string context, Ptr<const Packet> p)
+{
+  m_records[GetNode (context)].push_back (std::make_tuple (Simulator::Now ().GetNanoSeconds (), 0, 1));
+}
+
+void
+WifiPartitionTest::PhyRxDrop (std::string context, Ptr<const Packet> p, WifiPhyRxfailureReason reason)
+{
+  m_records[GetNode (context)].push_back (std::make_tuple (Simulator::Now ().GetNanoSeconds (), 0, 2));
+}
+
+WifiPartitionTest::Records
+WifiPartitionTest::RunSimulation (uint32_t nPartitions, bool allSenders)
+{
+  if (nPartitions > 0)
+    {
+      Simulator::SetImplementation (CreateObject<MultithreadedSimulatorImpl> ());
+    }
+  else
+    {
+      Simulator::SetImplementation (CreateObject<DefaultSimulatorImpl> ());
+    }
+
+  uint32_t nNodes = 8;
+  m_records.assign (nNodes, std::vector<Record> ());
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  Ptr<YansWifiChannel> channel = CreateObject<YansWifiChannel> ();
+  channel->SetPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  YansWifiPhyHelper phy;
+  phy.SetChannel (channel);
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211a);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("OfdmRate6Mbps"),
+                                "ControlMode", StringValue ("OfdmRate6Mbps"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices = wifi.Install (phy, mac, nodes);
+  wifi.AssignStreams (devices, 1);
+
+  MobilityHelper mobility;
+  mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+                                 "DeltaX", DoubleValue (10),
+                                 "GridWidth", UintegerValue (nNodes));
+  mobility.Install (nodes);
+
+  if (nPartitions > 0)
+    {
+      WifiPartitionHelper partition;
+      for (uint32_t i = 0; i < nNodes; i++)
+        {
+          partition.SetPartition (NodeContainer (nodes.Get (i)), i * nPartitions / nNodes);
+        }
+      Time lookahead = partition.Install ();
+      // 10 m between neighbors of different partitions
+      NS_TEST_EXPECT_MSG_EQ (lookahead, NanoSeconds (33), "Unexpected lookahead");
+    }
+
+  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxBegin",
+                   MakeCallback (&WifiPartitionTest::PhyRxBegin, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxEnd",
+                   MakeCallback (&WifiPartitionTest::PhyRxEnd, this));
+  Config::Connect ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxDrop",
+                   MakeCallback (&WifiPartitionTest::PhyRxDrop, this));
+
+  for (uint32_t i = 0; i < (allSenders ? nNodes : 1); i++)
+    {
+      Ptr<NetDevice> device = devices.Get (i);
+      for (uint32_t j = 0; j < 10; j++)
+        {
+          // frames are sent in bursts so that some of them overlap
+          Simulator::ScheduleWithContext (i, MilliSeconds (j * 10 + (i % 4)), &NetDevice::Send, device,
+                                          Create<Packet> (500), device->GetBroadcast (), 0x88b5);
+        }
+    }
+
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  return m_records;
+}
+
+void
+WifiPartitionTest::DoRun (void)
+{
+  Records reference = RunSimulation (0, false);
+  Records records = RunSimulation (4, false);
+  for (uint32_t i = 1; i < reference.size (); i++)
+    {
+      // the farthest nodes drop the frames
+      NS_TEST_EXPECT_MSG_GT_OR_EQ (reference[i].size (), 10, "Frames missed by node " << i);
+      NS_TEST_EXPECT_MSG_EQ ((records[i] == reference[i]), true, "Different PHY events for node " << i);
+    }
+
+  reference = RunSimulation (4, true);
+  records = RunSimulation (4, true);
+  uint32_t nEvents = 0;
+  for (uint32_t i = 0; i < reference.size (); i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ ((records[i] == reference[i]), true, "Different PHY events for node " << i);
+      nEvents += reference[i].size ();
+    }
+  NS_TEST_EXPECT_MSG_GT (nEvents, 0, "No frame received");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Wifi Partition Test Suite
+ */
+class WifiPartitionTestSuite : public TestSuite
+{
+public:
+  WifiPartitionTestSuite ();
+};
+
+WifiPartitionTestSuite::WifiPartitionTestSuite ()
+  : TestSuite ("wifi-partition", UNIT)
+{
+  AddTestCase (new WifiPartitionTest (), TestCase::QUICK);
+}
+
+static WifiPartitionTestSuite g_wifiPartitionTestSuite; ///< the test suite
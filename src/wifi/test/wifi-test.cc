@@ -3148,6 +3148,111 @@ HeRuMcsDataRateTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (retval, true, "Data rate verification for RUs above 52-tone RU (included) failed");
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that a PPDU is shared by all the PHYs receiving it (i.e., it is
+ * not copied for each receiver) on both YansWifiChannel and
+ * MultiModelSpectrumChannel.
+ */
+class SharedPpduTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param spectrum whether to use a MultiModelSpectrumChannel (rather than a YansWifiChannel)
+   */
+  SharedPpduTestCase (bool spectrum);
+
+private:
+  void DoRun (void) override;
+  /**
+   * PHY RX end trace sink
+   * \param p the packet
+   */
+  void PhyRxEnd (Ptr<const Packet> p);
+
+  bool m_spectrum; ///< whether to use a MultiModelSpectrumChannel
+  uint32_t m_rxOk; ///< number of frames successfully received by the PHYs
+};
+
+SharedPpduTestCase::SharedPpduTestCase (bool spectrum)
+  : TestCase (std::string ("Check that PPDUs are not copied for each receiver on a ")
+              + (spectrum ? "MultiModelSpectrumChannel" : "YansWifiChannel")),
+    m_spectrum (spectrum),
+    m_rxOk (0)
+{
+}
+
+void
+SharedPpduTestCase::PhyRxEnd (Ptr<const Packet> p)
+{
+  m_rxOk++;
+}
+
+void
+SharedPpduTestCase::DoRun (void)
+{
+  uint32_t nNodes = 5;
+  uint32_t nPackets = 3;
+  NodeContainer nodes;
+  nodes.Create (nNodes);
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_STANDARD_80211ax_5GHZ);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("HeMcs0"),
+                                "ControlMode", StringValue ("HeMcs0"));
+  WifiMacHelper mac;
+  mac.SetType ("ns3::AdhocWifiMac");
+  NetDeviceContainer devices;
+  if (m_spectrum)
+    {
+      Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+      channel->AddPropagationLossModel (CreateObject<FriisPropagationLossModel> ());
+      SpectrumWifiPhyHelper phy;
+      phy.SetChannel (channel);
+      devices = wifi.Install (phy, mac, nodes);
+    }
+  else
+    {
+      YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+      YansWifiPhyHelper phy;
+      phy.SetChannel (channel.Create ());
+      devices = wifi.Install (phy, mac, nodes);
+    }
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  for (uint32_t i = 0; i < nNodes; i++)
+    {
+      positionAlloc->Add (Vector (i, 0, 0));
+    }
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (nodes);
+
+  Config::ConnectWithoutContext ("/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyRxEnd",
+                                 MakeCallback (&SharedPpduTestCase::PhyRxEnd, this));
+
+  Ptr<NetDevice> device = devices.Get (0);
+  for (uint32_t i = 0; i < nPackets; i++)
+    {
+      Simulator::Schedule (MilliSeconds (1 + i), &NetDevice::Send, device,
+                           Create<Packet> (1000), device->GetBroadcast (), 0x88b5);
+    }
+
+  uint64_t nCreated = WifiPpdu::GetNCreated ();
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_rxOk, nPackets * (nNodes - 1), "All the receivers should have received all the frames");
+  NS_TEST_EXPECT_MSG_EQ (WifiPpdu::GetNCreated () - nCreated, nPackets, "A single PPDU should be created per transmission");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -3180,6 +3285,8 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new IdealRateManagerChannelWidthTest, TestCase::QUICK);
   AddTestCase (new IdealRateManagerMimoTest, TestCase::QUICK);
   AddTestCase (new HeRuMcsDataRateTestCase, TestCase::QUICK);
+  AddTestCase (new SharedPpduTestCase (false), TestCase::QUICK);
+  AddTestCase (new SharedPpduTestCase (true), TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+//
+// Benchmark the injection of events into a running simulation by other
+// threads, as done by the reader threads of the emulation net devices.
+//
+// For each number of producer threads of --producers, the simulator is
+// run while every producer schedules --events events with
+// Simulator::ScheduleWithContext. The wall-clock time until all the
+// events have been executed by the main thread is reported.
+//
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+uint64_t g_executed = 0; ///< number of injected events executed
+uint64_t g_expected = 0; ///< number of injected events expected
+std::vector<std::thread> g_producers; ///< the producer threads
+
+/** Injected event. */
+void
+Injected (void)
+{
+  if (++g_executed == g_expected)
+    {
+      Simulator::Stop ();
+    }
+}
+
+/**
+ * Keep the (non real time) simulation running until all the injected
+ * events have been executed.
+ */
+void
+KeepAlive (void)
+{
+  if (g_executed < g_expected)
+    {
+      Simulator::Schedule (NanoSeconds (1), &KeepAlive);
+    }
+}
+
+/**
+ * Producer thread.
+ *
+ * \param context the context of the injected events
+ * \param events the number of events to inject
+ */
+void
+Produce (uint32_t context, uint32_t events)
+{
+  for (uint32_t i = 0; i < events; i++)
+    {
+      Simulator::ScheduleWithContext (context, Seconds (0), &Injected);
+    }
+}
+
+/**
+ * Start the producer threads.
+ *
+ * \param producers the number of producer threads
+ * \param events the number of events injected by each thread
+ */
+void
+StartProducers (uint32_t producers, uint32_t events)
+{
+  for (uint32_t i = 0; i < producers; i++)
+    {
+      g_producers.push_back (std::thread (&Produce, i, events));
+    }
+}
+
+/**
+ * Run the benchmark.
+ *
+ * \param impl the simulator implementation type
+ * \param producers the number of producer threads
+ * \param events the number of events injected by each thread
+ * \return the wall-clock duration in seconds
+ */
+double
+Run (std::string impl, uint32_t producers, uint32_t events)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (impl);
+  Simulator::SetImplementation (factory.Create<SimulatorImpl> ());
+
+  g_executed = 0;
+  g_expected = static_cast<uint64_t> (producers) * events;
+  Simulator::ScheduleNow (&StartProducers, producers, events);
+  if (impl != "ns3::RealtimeSimulatorImpl")
+    {
+      Simulator::ScheduleNow (&KeepAlive);
+    }
+
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Run ();
+  double elapsed = clock.End () / 1000.0;
+
+  for (auto & producer : g_producers)
+    {
+      producer.join ();
+    }
+  g_producers.clear ();
+  Simulator::Destroy ();
+  return elapsed;
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string impl = "ns3::DefaultSimulatorImpl";
+  std::string producers = "1,2,4";
+  uint32_t events = 100000;
+
+  CommandLine cmd (__FILE__);
+  cmd.Usage ("Benchmark the injection of events by other threads.");
+  cmd.AddValue ("impl", "Simulator implementation type", impl);
+  cmd.AddValue ("producers", "Comma-separated list of the numbers of producer threads", producers);
+  cmd.AddValue ("events", "Number of events injected by each producer thread", events);
+  cmd.Parse (argc, argv);
+
+  std::cout << impl << std::endl
+            << std::setw (12) << "producers"
+            << std::setw (12) << "time (s)"
+            << std::setw (12) << "events"
+            << std::setw (14) << "ns per event" << std::endl;
+  std::size_t start = 0;
+  while (start < producers.size ())
+    {
+      std::size_t end = producers.find (',', start);
+      if (end == std::string::npos)
+        {
+          end = producers.size ();
+        }
+      uint32_t n = std::stoul (producers.substr (start, end - start));
+      start = end + 1;
+
+      double elapsed = Run (impl, n, events);
+      std::cout << std::setw (12) << n
+                << std::setw (12) << elapsed
+                << std::setw (12) << g_executed
+                << std::setw (14) << elapsed * 1e9 / g_executed << std::endl;
+    }
+
+  return 0;
+}
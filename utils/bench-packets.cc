@@ -26,6 +26,7 @@
 #include "ns3/system-wall-clock-ms.h"
 #include "ns3/packet.h"
 #include "ns3/packet-metadata.h"
+#include "ns3/packet-arena.h"
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -362,12 +363,14 @@ int main (int argc, char *argv[])
   uint32_t n = 0;
   uint32_t minIterations = 1;
   bool enablePrinting = false;
+  bool arenaStats = false;
 
   CommandLine cmd (__FILE__);
   cmd.Usage ("Benchmark Packet class");
   cmd.AddValue ("n", "number of iterations", n);
   cmd.AddValue ("min-iterations", "number of subiterations to minimize iteration time over", minIterations);
   cmd.AddValue ("enable-printing", "enable packet printing", enablePrinting);
+  cmd.AddValue ("arena-stats", "print the statistics of the packet arena", arenaStats);
   cmd.Parse (argc, argv);
 
   if (n == 0)
@@ -386,5 +389,11 @@ int main (int argc, char *argv[])
   runBench (&benchFragment, n, minIterations, "Fragmentation and concatenation");
   runBench (&benchByteTags, n, minIterations, "Benchmark byte tags");
 
+  if (arenaStats)
+    {
+      std::cout << "Packet arena:" << std::endl
+                << PacketArena::GetStats () << std::endl;
+    }
+
   return 0;
 }
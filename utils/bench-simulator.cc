@@ -208,6 +208,7 @@ int main (int argc, char *argv[])
   bool schedList          = false;
   bool schedMap           = true;
   bool schedPriorityQueue = false;
+  bool schedDaryHeap = false;
 
   uint32_t pop   =  100000;
   uint32_t total = 1000000;
@@ -230,6 +231,7 @@ int main (int argc, char *argv[])
   cmd.AddValue ("list",  "use ListSheduler",              schedList);
   cmd.AddValue ("map",   "use MapScheduler (default)",    schedMap);
   cmd.AddValue ("pri",   "use PriorityQueue",             schedPriorityQueue);
+  cmd.AddValue ("dary",  "use DaryHeapScheduler",         schedDaryHeap);
   cmd.AddValue ("debug", "enable debugging output",       g_debug);
   cmd.AddValue ("pop",   "event population size (default 1E5)",         pop);
   cmd.AddValue ("total", "total number of events to run (default 1E6)", total);
@@ -258,6 +260,10 @@ int main (int argc, char *argv[])
     {
       factory.SetTypeId ("ns3::PriorityQueueScheduler");
     }
+  if (schedDaryHeap)
+    {
+      factory.SetTypeId ("ns3::DaryHeapScheduler");
+    }
       
   Simulator::SetScheduler (factory);
 
@@ -316,6 +322,7 @@ int main (int argc, char *argv[])
 
   LOG ("");
   Simulator::Destroy ();
+  LOGME ("event allocator: " << EventImpl::GetAllocatorStats ());
   delete bench;
   return 0;
 }